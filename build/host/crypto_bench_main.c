@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * crypto_bench_main.c
+ *
+ ******************************************************************************
+ */
+
+#include "host_platform.h"
+#include "crypto_bench.h"
+#include "modRunner.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Names of scenarios, in order of crypto_bench.c */
+static const char* const scenarioNames[CRYPTO_BENCH_SCENARIOS] = {
+    "exp_mod 1024 (e = 65537)",
+    "exp_mod 1024 (private)",
+    "exp_mod 3072 (e = 65537)",
+    "pkcs1 v1.5 verify 3072",
+    "pkcs1 OAEP encrypt 1024",
+    "HMAC-SHA256 256 B",
+    "AES 256 B",
+};
+
+bool HOST_isFinished(void)
+{
+    return CRYPTO_BENCH_isFinished();
+}
+
+int HOST_report(void)
+{
+    const CryptoBenchResult_t* results = CRYPTO_BENCH_getResults();
+    uint32_t failures = 0U;
+    uint32_t i;
+    double opsPerSec;
+
+    (void)printf("%-26s %6s %10s %12s %10s %9s %9s %8s\n", "scenario", "ops", "total us",
+                 "ops/s", "max us", "expmod B", "heap B", "failures");
+
+    for (i = 0U; i < CRYPTO_BENCH_SCENARIOS; i++) {
+        opsPerSec = 0.0;
+        if (results[i].totalUs != 0U) {
+            opsPerSec = ((double)results[i].iterations * 1000000.0) / (double)results[i].totalUs;
+        }
+
+        (void)printf("%-26s %6u %10u %12.1f %10u %9u %9u %8u\n", scenarioNames[i],
+                     results[i].iterations, results[i].totalUs, opsPerSec, results[i].maxOperationUs,
+                     results[i].expModPeakMem, results[i].heapPeakMem, results[i].failures);
+
+        failures += results[i].failures;
+    }
+
+    return (failures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(void)
+{
+    HOST_init();
+    modRunnerInit();
+    CRYPTO_BENCH_InsertModule();
+
+    /* Does not return, program is finished by WatchdogClear (see host_platform.c) */
+    modRunnerRun();
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * host_platform.c
+ *
+ ******************************************************************************
+ */
+
+#include "host_platform.h"
+#include "reg.h"
+#include "mode.h"
+#include "timer.h"
+#include "watchdog.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <xtensa/hal.h>
+#include <xtensa/xtruntime.h>
+
+/* Benchmarks are run in active mode (defined by general_handler.c on target) */
+DpMode_t dpMode = DISPLAYPORT_FIRMWARE_ACTIVE;
+
+void HOST_init(void)
+{
+    mhdpRegBase = calloc(1U, sizeof(MHDP_ApbRegs));
+
+    if (mhdpRegBase == NULL) {
+        (void)fprintf(stderr, "host: cannot allocate register file\n");
+        exit(EXIT_FAILURE);
+    }
+
+    CPU_CLOCK_MEGA = HOST_CPU_CLOCK_MHZ;
+}
+
+unsigned xthal_get_ccount(void)
+{
+    struct timespec now;
+    uint64_t ns;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    ns = ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+
+    /* Counter wraps around as on core, timer.c calculates differences modulo 2^32 */
+    return (unsigned)((ns * HOST_CPU_CLOCK_MHZ) / 1000U);
+}
+
+void* xtos_set_interrupt_handler(int n, void (*f)(void*), void* arg, void (**old)(void*))
+{
+    /* Simulation models call interrupt handler directly (see interruptRaise) */
+    (void)n;
+    (void)f;
+    (void)arg;
+    (void)old;
+    return NULL;
+}
+
+unsigned xtos_interrupt_enable(unsigned n)
+{
+    (void)n;
+    return 0U;
+}
+
+void WatchdogClear(void)
+{
+    static unsigned lastPass;
+
+    /* Called by modRunnerRun after every pass over modules */
+    if (HOST_isFinished()) {
+        exit(HOST_report());
+    }
+
+    /* Pass on host may be shorter than 1 us (minimum on core, see watchdog.h), then
+     * modRunner gets 0 us from timer.c and sleeping modules would never wake up on time */
+    while ((xthal_get_ccount() - lastPass) < HOST_CPU_CLOCK_MHZ) {
+    }
+    lastPass = xthal_get_ccount();
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * host_platform.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+/**
+ *  \file host_platform.h
+ *  \brief Platform layer of host (Linux) build of benchmark drivers
+ *
+ * Firmware sources (modRunner, timer, cps and drivers) are built unchanged.
+ * Hardware is replaced by:
+ * - register file allocated in memory; accesses go through
+ *   CPS_ReadReg32/CPS_WriteReg32, so simulation models serve their
+ *   registers in the same way as on instruction set simulator,
+ * - core cycle counter (xthal_get_ccount) derived from monotonic clock,
+ * - watchdog, which is cleared after every modRunner pass and stops
+ *   the program when benchmark is finished.
+ */
+#include "cdn_stdtypes.h"
+
+/* Simulated core clock (MHz) */
+#define HOST_CPU_CLOCK_MHZ 100U
+
+/**
+ * Allocate register file and set core clock, has to be called before
+ * modRunnerInit
+ */
+void HOST_init(void);
+
+/**
+ * Check if benchmark is finished, implemented by benchmark main.
+ * Called after every modRunner pass.
+ * @return 'true' to stop modRunner
+ */
+bool HOST_isFinished(void);
+
+/**
+ * Print results of benchmark, implemented by benchmark main
+ * @return exit status of program
+ */
+int HOST_report(void);
+
+#endif /* HOST_PLATFORM_H */
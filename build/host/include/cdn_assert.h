@@ -0,0 +1,10 @@
+/**
+ * Host build stub of CPS header, see build/host/Makefile
+ */
+
+#ifndef CDN_ASSERT_H
+#define CDN_ASSERT_H
+
+#include <assert.h>
+
+#endif /* CDN_ASSERT_H */
@@ -0,0 +1,18 @@
+/**
+ * Host build stub of CPS header, see build/host/Makefile
+ */
+
+#ifndef CDN_ERRNO_H
+#define CDN_ERRNO_H
+
+#include "cdn_stdint.h"
+
+typedef uint32_t CDN_ERRNO;
+
+#define CDN_EOK          0U
+#define CDN_ENOMEM       12U
+#define CDN_EINVAL       22U
+#define CDN_ENOSPC       28U
+#define CDN_EINPROGRESS  115U
+
+#endif /* CDN_ERRNO_H */
@@ -0,0 +1,10 @@
+/**
+ * Host build stub of CPS header, see build/host/Makefile
+ */
+
+#ifndef CDN_INTTYPES_H
+#define CDN_INTTYPES_H
+
+#include <inttypes.h>
+
+#endif /* CDN_INTTYPES_H */
@@ -0,0 +1,30 @@
+/**
+ * Host build stub of CPS header, see build/host/Makefile
+ *
+ * Messages up to HOST_LOG_LEVEL are printed to stderr, so stdout is left
+ * for results printed by benchmark main.
+ */
+
+#ifndef CDN_LOG_H
+#define CDN_LOG_H
+
+#include <stdio.h>
+
+#define DBG_GEN_MSG 0x00000001U
+
+#define DBG_CRIT   0U
+#define DBG_WARN   5U
+#define DBG_FYI    10U
+
+#ifndef HOST_LOG_LEVEL
+#define HOST_LOG_LEVEL DBG_CRIT
+#endif
+
+#define cDbgMsg(module, level, ...) \
+    do { \
+        if ((level) <= HOST_LOG_LEVEL) { \
+            (void)fprintf(stderr, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#endif /* CDN_LOG_H */
@@ -0,0 +1,10 @@
+/**
+ * Host build stub of CPS header, see build/host/Makefile
+ */
+
+#ifndef CDN_STDINT_H
+#define CDN_STDINT_H
+
+#include <stdint.h>
+
+#endif /* CDN_STDINT_H */
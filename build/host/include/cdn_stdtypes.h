@@ -0,0 +1,12 @@
+/**
+ * Host build stub of CPS header, see build/host/Makefile
+ */
+
+#ifndef CDN_STDTYPES_H
+#define CDN_STDTYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#endif /* CDN_STDTYPES_H */
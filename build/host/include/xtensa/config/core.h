@@ -0,0 +1,11 @@
+/**
+ * Host build stub of Xtensa core configuration, see build/host/Makefile
+ */
+
+#ifndef XTENSA_CONFIG_CORE_H
+#define XTENSA_CONFIG_CORE_H
+
+/* Host has 32x32->64 multiplication */
+#define XCHAL_HAVE_MUL32_HIGH 1
+
+#endif /* XTENSA_CONFIG_CORE_H */
@@ -0,0 +1,11 @@
+/**
+ * Host build stub of Xtensa HAL header, see build/host/Makefile
+ */
+
+#ifndef XTENSA_HAL_H
+#define XTENSA_HAL_H
+
+/* Core cycle counter, implemented by host_platform.c */
+unsigned xthal_get_ccount(void);
+
+#endif /* XTENSA_HAL_H */
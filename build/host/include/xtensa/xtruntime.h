@@ -0,0 +1,12 @@
+/**
+ * Host build stub of Xtensa runtime header, see build/host/Makefile
+ */
+
+#ifndef XTENSA_XTRUNTIME_H
+#define XTENSA_XTRUNTIME_H
+
+/* Interrupts are not used on host, implemented by host_platform.c */
+void* xtos_set_interrupt_handler(int n, void (*f)(void*), void* arg, void (**old)(void*));
+unsigned xtos_interrupt_enable(unsigned n);
+
+#endif /* XTENSA_XTRUNTIME_H */
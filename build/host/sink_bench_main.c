@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * sink_bench_main.c
+ *
+ ******************************************************************************
+ */
+
+#include "host_platform.h"
+#include "sink_bench.h"
+#include "sink_model.h"
+#include "dp_tx.h"
+#include "dp_tx_mail_handler.h"
+#include "modRunner.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Names of scenarios, in order of sink_bench.c */
+static const char* const scenarioNames[SINK_BENCH_SCENARIOS] = {
+    "fast sink (50 us)",
+    "slow sink (250 us)",
+    "every 4th DEFER",
+    "every 8th no reply",
+};
+
+/* Number of HPD events reported by DP_TX (no host mailbox in this build) */
+static uint32_t hpdEvents;
+
+void DP_TX_MAIL_HANDLER_notifyHpdEv(uint8_t eventCode)
+{
+    (void)eventCode;
+    hpdEvents++;
+}
+
+bool HOST_isFinished(void)
+{
+    return SINK_BENCH_isFinished();
+}
+
+int HOST_report(void)
+{
+    const SinkBenchResult_t* results = SINK_BENCH_getResults();
+    uint32_t failures = 0U;
+    uint32_t i;
+    uint32_t avgUs;
+
+    (void)printf("%-20s %5s %10s %8s %8s %6s %6s %8s %8s %8s\n", "scenario", "seqs", "total us",
+                 "avg us", "max us", "AUX", "I2C", "retries", "timeouts", "failures");
+
+    for (i = 0U; i < SINK_BENCH_SCENARIOS; i++) {
+        avgUs = 0U;
+        if (results[i].iterations != 0U) {
+            avgUs = results[i].totalUs / results[i].iterations;
+        }
+
+        (void)printf("%-20s %5u %10u %8u %8u %6u %6u %8u %8u %8u\n", scenarioNames[i],
+                     results[i].iterations, results[i].totalUs, avgUs, results[i].maxSequenceUs,
+                     results[i].auxTransactions, results[i].i2cTransactions, results[i].retries,
+                     results[i].timeouts, results[i].failures);
+
+        failures += results[i].failures;
+    }
+
+    (void)printf("HPD events: %u\n", hpdEvents);
+
+    return (failures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(void)
+{
+    HOST_init();
+    modRunnerInit();
+
+    /* Same order as general_handler.c: virtual sink before DP_TX */
+    SINK_MODEL_InsertModule();
+    SINK_BENCH_InsertModule();
+    DP_TX_InsertModule();
+
+    /* Does not return, program is finished by WatchdogClear (see host_platform.c) */
+    modRunnerRun();
+
+    return EXIT_FAILURE;
+}
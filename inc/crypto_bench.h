@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * crypto_bench.h
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_CRYPTO_BENCH
+
+#ifndef CRYPTO_BENCH_H
+#define CRYPTO_BENCH_H
+/**
+ *  \file crypto_bench.h
+ *  \brief Crypto benchmark driver, for simulation and benchmarking purpose only
+ *
+ * Driver runs modular exponentiation (1024 and 3072 bits), PKCS#1 signature
+ * verification and OAEP encryption, HMAC-SHA256 and AES on fixed test vectors
+ * and reports number of operations per second and memory high-water marks.
+ * HDCP authentication must not be started while benchmark is running, as
+ * both use the same bignum calculation state. SHA-256 and AES-32 engines are
+ * replaced by software model (see crypto_model.h), so the build option is
+ * intended for instruction set simulator.
+ */
+#include "modRunner.h"
+#include "cdn_stdint.h"
+
+/* Number of benchmark scenarios */
+#define CRYPTO_BENCH_SCENARIOS 7U
+
+/**
+ * Result of single benchmark scenario
+ */
+typedef struct {
+    /* Number of finished operations */
+    uint32_t iterations;
+    /* Number of operations finished with error or unexpected result */
+    uint32_t failures;
+    /* Number of module thread calls needed by all operations */
+    uint32_t steps;
+    /* Time of all operations in microseconds */
+    uint32_t totalUs;
+    /* Time of the longest operation in microseconds */
+    uint32_t maxOperationUs;
+    /* The largest memory used by exponentiation temporaries (bytes) */
+    uint32_t expModPeakMem;
+    /* The largest memory allocated from heap during scenario (bytes) */
+    uint32_t heapPeakMem;
+} CryptoBenchResult_t;
+
+/**
+ * Get results of benchmark
+ * @return pointer to array of CRYPTO_BENCH_SCENARIOS results
+ */
+const CryptoBenchResult_t* CRYPTO_BENCH_getResults(void);
+
+/**
+ * Check if benchmark is finished
+ * @return 'true' if results of all scenarios are ready
+ */
+bool CRYPTO_BENCH_isFinished(void);
+
+/**
+ * Attach module to system
+ */
+void CRYPTO_BENCH_InsertModule(void);
+
+#endif //CRYPTO_BENCH_H
+
+#endif // USE_CRYPTO_BENCH
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * crypto_model.h
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_CRYPTO_BENCH
+
+#ifndef CRYPTO_MODEL_H
+#define CRYPTO_MODEL_H
+/**
+ *  \file crypto_model.h
+ *  \brief software model of SHA-256 and AES-32 engines, for simulation and
+ *         benchmarking purpose only
+ *
+ * Model replaces SHA-256 and AES-32 blocks of crypto engine, which are not
+ * present in instruction set simulator. It intercepts accesses to their
+ * registers (see CPS_ReadReg32/CPS_WriteReg32), calculates result when the
+ * last word of block is written and sets status flag polled by sha.c and
+ * aes.c drivers.
+ */
+#include "cdn_stdint.h"
+#include "cdn_stdtypes.h"
+
+/**
+ * Serve read of register owned by model
+ * @param[in] address, address of register
+ * @param[out] value, value of register
+ * @return 'true' if register is owned by model or 'false' if access should go to hardware
+ */
+bool CRYPTO_MODEL_regRead(const volatile uint32_t* address, uint32_t* value);
+
+/**
+ * Serve write of register owned by model
+ * @param[in] address, address of register
+ * @param[in] value, written value
+ * @return 'true' if register is owned by model or 'false' if access should go to hardware
+ */
+bool CRYPTO_MODEL_regWrite(const volatile uint32_t* address, uint32_t value);
+
+#endif //CRYPTO_MODEL_H
+
+#endif // USE_CRYPTO_BENCH
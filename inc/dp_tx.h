@@ -87,17 +87,83 @@ typedef struct
     uint8_t* buffer;
 } DpTxRequestData_t;
 
+/* Number of buckets in latency histograms. Bucket 'n' counts latencies
+ * in range [2^n, 2^(n+1)) microseconds, first bucket counts also 0 us
+ * and last bucket counts all latencies above its lower limit */
+#define DP_TX_STATS_HIST_BUCKETS 10U
+
+/**
+ * Statistics of transactions, collected separately for AUX and I2C-over-AUX
+ */
+typedef struct
+{
+    /* Number of transactions (up to 16 bytes) sent to sink */
+    uint32_t transactions;
+    /* Number of ACK replies */
+    uint32_t ackCount;
+    /* Number of NACK replies */
+    uint32_t nackCount;
+    /* Number of DEFER replies */
+    uint32_t deferCount;
+    /* Number of invalid replies (reserved reply code or missing stop condition) */
+    uint32_t invalidCount;
+    /* Number of transactions without TX_DONE or reply in required time */
+    uint32_t timeoutCount;
+    /* Number of transactions sent again after DEFER or timeout */
+    uint32_t retryCount;
+    /* Number of bytes read/written by sink */
+    uint32_t bytes;
+    /* Histogram of time between sending request and TX_DONE interrupt */
+    uint32_t txDoneHist[DP_TX_STATS_HIST_BUCKETS];
+    /* Histogram of time between TX_DONE and RX_DONE interrupts */
+    uint32_t rxDoneHist[DP_TX_STATS_HIST_BUCKETS];
+} DpTxChannelStats_t;
+
+/**
+ * Statistics of DP_TX module
+ */
+typedef struct
+{
+    /* Statistics of native AUX transactions */
+    DpTxChannelStats_t aux;
+    /* Statistics of I2C-over-AUX transactions */
+    DpTxChannelStats_t i2c;
+} DpTxStats_t;
+
 /**
  *  Callback function given by policy and called after processing the request
  */
 typedef void (*ResponseCallback_t)(const DpTxRequestData_t* reply);
 
+/* Passed as timeout to DP_TX_submitWhenFree, if client waits as long as sink is plugged */
+#define DP_TX_SUBMIT_NO_TIMEOUT 0U
+
+/**
+ * Result of submitting request by client module of DP_TX
+ */
+typedef enum {
+    /* Request was added, client callback is called after request is finished */
+    DP_TX_SUBMIT_STATUS_SUBMITTED = 0U,
+    /* DP_TX module is busy, client should try again in next dispatch */
+    DP_TX_SUBMIT_STATUS_WAITING = 1U,
+    /* Sink is unplugged, request was not added */
+    DP_TX_SUBMIT_STATUS_NO_SINK = 2U,
+    /* DP_TX module was busy for too long, request was not added */
+    DP_TX_SUBMIT_STATUS_TIMEOUT = 3U
+} DpTxSubmitStatus_t;
+
 /**
  *  Checks if another request can be added
  *  @return 'true' if can or 'false' if busy
  */
 bool DP_TX_isAvailable(void);
 
+/**
+ *  Checks if sink is plugged
+ *  @return 'true' if plugged or 'false' if not
+ */
+bool DP_TX_isPlugged(void);
+
 /**
  * Attach module to system
  */
@@ -115,12 +181,6 @@ void DP_TX_connect(void);
  */
 void DP_TX_disconnect(void);
 
-/**
- *  Set interrupt state, notify policy about HPD interrupt signal sink - should
- *  be called by HPD interrupt handler
- */
-void DP_TX_interrupt(void);
-
 /**
  *  Indicate that the data was sent from the Tx mailbox to the sink
  */
@@ -131,11 +191,36 @@ void DP_TX_setTxFlag(void);
  */
 void DP_TX_setRxFlag(void);
 
+/**
+ *  Indicate that the sink did not reply before reply timer expired
+ */
+void DP_TX_setTimeoutFlag(void);
+
 /**
  *  Add new request if possible, should be called by policy to read/write data
  */
 void DP_TX_addRequest(DpTxRequestData_t* request, ResponseCallback_t callback);
 
+/**
+ * Add request of client module (link training, sequencer, etc.) as soon as DP_TX module
+ * is free. Should be called in each dispatch of client thread, until request is submitted.
+ * @param[in] request, request to add
+ * @param[in] callback, function called after request is finished
+ * @param[in] elapsedMs, time spent by client on current operation
+ * @param[in] timeoutMs, limit of elapsedMs or DP_TX_SUBMIT_NO_TIMEOUT
+ * @return DP_TX_SUBMIT_STATUS_SUBMITTED if request was added, DP_TX_SUBMIT_STATUS_WAITING
+ *         if DP_TX module is busy, DP_TX_SUBMIT_STATUS_NO_SINK if sink is unplugged or
+ *         DP_TX_SUBMIT_STATUS_TIMEOUT if elapsedMs exceeded timeoutMs
+ */
+DpTxSubmitStatus_t DP_TX_submitWhenFree(DpTxRequestData_t* request, ResponseCallback_t callback,
+                                        uint32_t elapsedMs, uint32_t timeoutMs);
+
+/**
+ * State of client module waiting for the end of submitted request,
+ * state is changed by callback of request
+ */
+void DP_TX_waitRequestHandler(void);
+
 /**
  * Stop execute of current request and cleanup state of DP TX module
  */
@@ -146,4 +231,15 @@ void DP_TX_removeRequest(DpTxRequestData_t* request, ResponseCallback_t callback
  */
 void DP_TX_hdpInit(void);
 
+/**
+ * Get statistics of AUX and I2C-over-AUX transactions
+ * @return pointer to statistics structure
+ */
+const DpTxStats_t* DP_TX_getStats(void);
+
+/**
+ * Clear statistics of AUX and I2C-over-AUX transactions
+ */
+void DP_TX_resetStats(void);
+
 #endif /*DP_TX_H*/
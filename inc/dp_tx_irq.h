@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_irq.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef DP_TX_IRQ_H
+#define DP_TX_IRQ_H
+/**
+ *  \file dp_tx_irq.h
+ *  \brief Service routine of IRQ_HPD
+ *
+ * After IRQ_HPD, DEVICE_SERVICE_IRQ_VECTOR and LINK_SERVICE_IRQ_VECTOR_ESI0
+ * are read once and acknowledged. Set bits are dispatched to firmware
+ * modules (CP_IRQ to HDCP, link status change to link monitor) and host
+ * is notified by single HPD event, vectors are read by
+ * DPTX_READ_IRQ_VECTORS command.
+ */
+#include "modRunner.h"
+#include "cdn_stdtypes.h"
+
+/* Address of DEVICE_SERVICE_IRQ_VECTOR DPCD register */
+#define DPCD_DEVICE_SERVICE_IRQ_VECTOR_ADDR   0x00201U
+/* Address of LINK_SERVICE_IRQ_VECTOR_ESI0 DPCD register */
+#define DPCD_LINK_SERVICE_IRQ_VECTOR_ADDR     0x02005U
+
+/* Bits of DEVICE_SERVICE_IRQ_VECTOR */
+#define DP_TX_IRQ_AUTOMATED_TEST_REQUEST 0x02U
+#define DP_TX_IRQ_CP_IRQ                 0x04U
+#define DP_TX_IRQ_MCCS_IRQ               0x08U
+
+/* Bits of LINK_SERVICE_IRQ_VECTOR_ESI0 */
+#define DP_TX_IRQ_LINK_STATUS_CHANGED    0x02U
+
+/**
+ * Attach module to system
+ */
+void DP_TX_IRQ_InsertModule(void);
+
+#endif /* DP_TX_IRQ_H */
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_link_monitor.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef DP_TX_LINK_MONITOR_H
+#define DP_TX_LINK_MONITOR_H
+/**
+ *  \file dp_tx_link_monitor.h
+ *  \brief Background monitor of sink link status
+ *
+ * When enabled, lane and alignment status (DPCD 202h-207h) is read
+ * periodically and when IRQ_HPD service reports change of link status.
+ * Host is notified by EVENT_ID_DPTX_LINK_STATUS event only if CR_DONE,
+ * EQ_DONE, SYMBOL_LOCKED or INTERLANE_ALIGN_DONE bits were changed.
+ * Monitor is paused during link training.
+ */
+#include "modRunner.h"
+#include "cdn_stdtypes.h"
+
+/**
+ * Set period of link status reads
+ * @param[in] intervalMs, period in milliseconds, 0 disables monitor
+ */
+void DP_TX_LM_setInterval(uint16_t intervalMs);
+
+/**
+ * Request read of link status as soon as possible, ignored if monitor is disabled
+ */
+void DP_TX_LM_requestRead(void);
+
+/**
+ * Get link status reported by the latest event
+ * @param[out] status, buffer for DPCD 202h-207h values (6 bytes)
+ * @return number of changes since previous call (saturated to 255)
+ */
+uint8_t DP_TX_LM_getStatus(uint8_t* status);
+
+/**
+ * Attach module to system
+ */
+void DP_TX_LM_InsertModule(void);
+
+#endif /* DP_TX_LINK_MONITOR_H */
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_link_training.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef DP_TX_LINK_TRAINING_H
+#define DP_TX_LINK_TRAINING_H
+
+#include "modRunner.h"
+#include "cdn_stdtypes.h"
+
+/* Maximum number of lanes */
+#define DP_TX_LT_MAX_LANES 4U
+
+/* Size of lane status block (DPCD 202h-207h) */
+#define DP_TX_LT_LANE_STATUS_SIZE 6U
+
+/**
+ * Result of link training
+ */
+typedef enum {
+    /* Link trained */
+    DP_TX_LT_STATUS_SUCCESS = 0x00U,
+    /* Clock recovery failed on one lane */
+    DP_TX_LT_STATUS_CR_FAILED = 0x01U,
+    /* Channel equalization failed on one lane */
+    DP_TX_LT_STATUS_EQ_FAILED = 0x02U,
+    /* Training failed on all lane counts, host should lower link rate
+     * (PHY PLL is configured by host) and start training again */
+    DP_TX_LT_STATUS_REDUCE_RATE = 0x03U,
+    /* Training aborted (AUX error, unplug or invalid parameters) */
+    DP_TX_LT_STATUS_ABORTED = 0x04U,
+    /* Training in progress */
+    DP_TX_LT_STATUS_IN_PROGRESS = 0x05U
+} DpTxLtStatus_t;
+
+/**
+ * Parameters of link training given by host
+ */
+typedef struct {
+    /* Link rate, value of LINK_BW_SET DPCD register (PHY must be configured for it) */
+    uint8_t linkRate;
+    /* Maximum number of lanes (1, 2 or 4) */
+    uint8_t laneCount;
+    /* Maximum voltage swing level supported by source (0-3) */
+    uint8_t maxVoltageSwing;
+    /* Maximum pre-emphasis level supported by source (0-3) */
+    uint8_t maxPreEmphasis;
+    /* Enable enhanced framing, if supported by sink */
+    bool enhancedFraming;
+    /* Source supports TPS3 */
+    bool tps3Supported;
+    /* Source supports TPS4 */
+    bool tps4Supported;
+    /* Start from settings remembered for the sink, if any */
+    bool useCache;
+} DpTxLtParams_t;
+
+/**
+ * Result of link training
+ */
+typedef struct {
+    /* Status of training */
+    DpTxLtStatus_t status;
+    /* Trained link rate (LINK_BW_SET) */
+    uint8_t linkRate;
+    /* Trained number of lanes */
+    uint8_t laneCount;
+    /* Values of TRAINING_LANEx_SET DPCD registers */
+    uint8_t laneSet[DP_TX_LT_MAX_LANES];
+    /* Last read lane status (DPCD 202h-207h) */
+    uint8_t laneStatus[DP_TX_LT_LANE_STATUS_SIZE];
+    /* Number of clock recovery iterations */
+    uint8_t crLoops;
+    /* Number of channel equalization iterations */
+    uint8_t eqLoops;
+    /* Duration of training in microseconds */
+    uint32_t durationUs;
+    /* Settings remembered for the sink were used */
+    bool cached;
+} DpTxLtResult_t;
+
+/**
+ * Start link training, host is notified by EVENT_ID_DPTX_TRAINING event
+ * after finish. Request is ignored if training is in progress.
+ * Settings of the last successful training are remembered for few sinks,
+ * identified by receiver capability and sink OUI. If the same sink is
+ * trained again, remembered settings are verified by single channel
+ * equalization step and full training is done only if it fails.
+ * @param[in] params, parameters of training
+ */
+void DP_TX_LT_start(const DpTxLtParams_t* params);
+
+/**
+ * Check if link training is in progress
+ * @return 'true' if in progress or 'false' if not
+ */
+bool DP_TX_LT_isBusy(void);
+
+/**
+ * Get result of last link training
+ * @return pointer to result structure
+ */
+const DpTxLtResult_t* DP_TX_LT_getResult(void);
+
+/**
+ * Attach module to system
+ */
+void DP_TX_LT_InsertModule(void);
+
+#endif /* DP_TX_LINK_TRAINING_H */
@@ -24,8 +24,10 @@
 #define DP_TX_EVENT_CODE_HPD_LOW            0x02U
 #define DP_TX_EVENT_CODE_HPD_PULSE          0x04U
 #define DP_TX_EVENT_CODE_HPD_STATE_HIGH     0x08U
-
-extern uint8_t hpdState;
+#define DP_TX_EVENT_CODE_TRAINING_DONE      0x10U
+#define DP_TX_EVENT_CODE_TRAINING_FAILED    0x20U
+#define DP_TX_EVENT_CODE_LINK_STATUS        0x40U
+#define DP_TX_EVENT_CODE_SINK_SNAPSHOT      0x80U
 
 /**
  * Function used to insert DP_TX_MAIL_HANDLER module into context
@@ -43,4 +45,29 @@ void DP_TX_MAIL_HANDLER_initOnReset(void);
  */
 void DP_TX_MAIL_HANDLER_notifyHpdEv(uint8_t eventCode);
 
+/**
+ * Send to host notification about finish of link training.
+ * @param[in] eventCode, code of event
+ */
+void DP_TX_MAIL_HANDLER_notifyTrainingEv(uint8_t eventCode);
+
+/**
+ * Send to host notification about change of link status, detected by
+ * link monitor.
+ */
+void DP_TX_MAIL_HANDLER_notifyLinkStatusEv(void);
+
+/**
+ * Send to host notification that sink snapshot is ready.
+ */
+void DP_TX_MAIL_HANDLER_notifySnapshotEv(void);
+
+/**
+ * Send to host notification about IRQ_HPD, after IRQ vectors were serviced.
+ * Vectors are accumulated until host reads them.
+ * @param[in] deviceVector, value of DEVICE_SERVICE_IRQ_VECTOR
+ * @param[in] linkVector, value of LINK_SERVICE_IRQ_VECTOR_ESI0
+ */
+void DP_TX_MAIL_HANDLER_notifyIrqEv(uint8_t deviceVector, uint8_t linkVector);
+
 #endif /* DP_TX_MAIL_HANDLER_H */
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_sequencer.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef DP_TX_SEQUENCER_H
+#define DP_TX_SEQUENCER_H
+/**
+ *  \file dp_tx_sequencer.h
+ *  \brief Interpreter of AUX/I2C-over-AUX sequences uploaded by host
+ *
+ * Sequence is a list of instructions, each one is opcode byte followed by
+ * operands. Multi-byte operands are sent MSB first.
+ *
+ * | Opcode | Instruction | Operands                       | Description                            |
+ * |--------|-------------|--------------------------------|----------------------------------------|
+ * | 0x00   | END         | -                              | Finish sequence with success           |
+ * | 0x01   | AUX_READ    | addr[3], len[1]                | Read DPCD, data are appended to result |
+ * | 0x02   | AUX_WRITE   | addr[3], len[1], data[len]     | Write DPCD                             |
+ * | 0x03   | I2C_READ    | addr[1], len[1], mot[1]        | I2C read, data are appended to result  |
+ * | 0x04   | I2C_WRITE   | addr[1], len[1], mot[1], data  | I2C write                              |
+ * | 0x05   | SLEEP       | us[2]                          | Sleep for given time                   |
+ * | 0x06   | BRANCH_EQ   | mask[1], value[1], offset[1]   | Jump if (last & mask) == value         |
+ * | 0x07   | BRANCH_NE   | mask[1], value[1], offset[1]   | Jump if (last & mask) != value         |
+ * | 0x08   | ACC_ADD     | mask[1]                        | Add (last & mask) to accumulator       |
+ * | 0x09   | ACC_OR      | mask[1]                        | OR (last & mask) into accumulator      |
+ *
+ * 'last' is the first byte read by the latest read instruction. Branch
+ * offset is signed and relative to the next instruction.
+ */
+#include "modRunner.h"
+#include "cdn_stdtypes.h"
+
+/* Maximum size of sequence in bytes */
+#define DP_TX_SEQ_PROGRAM_SIZE 256U
+
+/* Maximum number of bytes read by sequence */
+#define DP_TX_SEQ_RESULT_SIZE 128U
+
+/**
+ * Status of sequence
+ */
+typedef enum {
+    /* END instruction reached */
+    DP_TX_SEQ_STATUS_SUCCESS = 0x00U,
+    /* AUX or I2C transaction failed */
+    DP_TX_SEQ_STATUS_AUX_ERROR = 0x01U,
+    /* Invalid opcode, operands out of sequence or result buffer full */
+    DP_TX_SEQ_STATUS_INVALID = 0x02U,
+    /* Maximum number of executed instructions reached */
+    DP_TX_SEQ_STATUS_STEP_LIMIT = 0x03U,
+    /* DP_TX module was not available */
+    DP_TX_SEQ_STATUS_TIMEOUT = 0x04U
+} DpTxSeqStatus_t;
+
+/**
+ * Result of sequence
+ */
+typedef struct {
+    /* Status of sequence */
+    DpTxSeqStatus_t status;
+    /* Offset of instruction, which finished sequence */
+    uint16_t pc;
+    /* Value of accumulator */
+    uint32_t acc;
+    /* Number of bytes read */
+    uint8_t length;
+    /* Bytes read by read instructions */
+    uint8_t data[DP_TX_SEQ_RESULT_SIZE];
+} DpTxSeqResult_t;
+
+/**
+ * Save sequence, which is run by DP_TX_SEQ_run()
+ * @param[in] program, instructions
+ * @param[in] length, size of sequence in bytes
+ * @return 'true' if saved or 'false' if sequence is too long or is running
+ */
+bool DP_TX_SEQ_upload(const uint8_t* program, uint16_t length);
+
+/**
+ * Start saved sequence, request is ignored if sequence is running
+ */
+void DP_TX_SEQ_run(void);
+
+/**
+ * Check if sequence is running
+ * @return 'true' if running or 'false' if not
+ */
+bool DP_TX_SEQ_isBusy(void);
+
+/**
+ * Get result of last sequence
+ * @return pointer to result structure
+ */
+const DpTxSeqResult_t* DP_TX_SEQ_getResult(void);
+
+/**
+ * Attach module to system
+ */
+void DP_TX_SEQ_InsertModule(void);
+
+#endif /* DP_TX_SEQUENCER_H */
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_snapshot.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef DP_TX_SNAPSHOT_H
+#define DP_TX_SNAPSHOT_H
+/**
+ *  \file dp_tx_snapshot.h
+ *  \brief Sink discovery snapshot
+ *
+ * Right after sink is plugged, data usually read by host during discovery
+ * are read by firmware and kept in single versioned blob. Host is notified
+ * by EVENT_ID_DPTX_SINK_SNAPSHOT event, when blob is ready.
+ *
+ * Layout of blob (version 1):
+ * | Offset  | Size | Content                                        |
+ * |---------|------|------------------------------------------------|
+ * | 0       | 1    | Version of layout                              |
+ * | 1       | 1    | Mask of valid fields (DP_TX_SNAPSHOT_VALID_*)  |
+ * | 2-17    | 16   | Receiver capability (DPCD 00000h-0000Fh)       |
+ * | 18      | 1    | MSTM_CAP (DPCD 00021h)                         |
+ * | 19-21   | 3    | HDCP2 RxCaps (DPCD 6921Dh-6921Fh)              |
+ * | 22      | 1    | HDCP1 Bcaps (DPCD 68028h)                      |
+ * | 23-150  | 128  | EDID base block                                |
+ */
+#include "modRunner.h"
+#include "cdn_stdtypes.h"
+
+/* Version of snapshot layout */
+#define DP_TX_SNAPSHOT_VERSION 1U
+
+/* Size of snapshot blob */
+#define DP_TX_SNAPSHOT_SIZE 151U
+
+/* Bits of mask of valid fields */
+#define DP_TX_SNAPSHOT_VALID_CAPS   0x01U
+#define DP_TX_SNAPSHOT_VALID_MSTM   0x02U
+#define DP_TX_SNAPSHOT_VALID_RXCAPS 0x04U
+#define DP_TX_SNAPSHOT_VALID_BCAPS  0x08U
+#define DP_TX_SNAPSHOT_VALID_EDID   0x10U
+
+/**
+ * State of snapshot
+ */
+typedef enum {
+    /* Snapshot is ready */
+    DP_TX_SNAPSHOT_STATE_READY = 0x00U,
+    /* Snapshot is being read */
+    DP_TX_SNAPSHOT_STATE_IN_PROGRESS = 0x01U,
+    /* Sink is not plugged */
+    DP_TX_SNAPSHOT_STATE_NO_SINK = 0x02U
+} DpTxSnapshotState_t;
+
+/**
+ * Start reading of snapshot, called when sink is plugged
+ */
+void DP_TX_SNAPSHOT_start(void);
+
+/**
+ * Get snapshot
+ * @param[out] state, state of snapshot
+ * @return pointer to blob of DP_TX_SNAPSHOT_SIZE bytes, valid only
+ *         if state is DP_TX_SNAPSHOT_STATE_READY
+ */
+const uint8_t* DP_TX_SNAPSHOT_get(DpTxSnapshotState_t* state);
+
+/**
+ * Attach module to system
+ */
+void DP_TX_SNAPSHOT_InsertModule(void);
+
+#endif /* DP_TX_SNAPSHOT_H */
@@ -26,8 +26,8 @@
 typedef enum {
     EVENT_ID_DPTX_HPD = 0x01U,
     EVENT_ID_DPTX_TRAINING = 0x02U,
-    EVENT_ID_RESERVE0 = 0x04U,
-    EVENT_ID_RESERVE1 = 0x08U,
+    EVENT_ID_DPTX_LINK_STATUS = 0x04U,
+    EVENT_ID_DPTX_SINK_SNAPSHOT = 0x08U,
     EVENT_ID_HDCPTX_STATUS = 0x10U,
     EVENT_ID_HDCPTX_IS_KM_STORED = 0x20U,
     EVENT_ID_HDCPTX_STORE_KM = 0x40U,
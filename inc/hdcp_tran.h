@@ -22,6 +22,7 @@
 #include "utils.h"
 #include "engine.h"
 #include "modRunner.h"
+#include "hpd_events.h"
 
 /* Mask for valid receiver message */
 #define HDCP_MSG_IS_REC_ID_VALID_MASK 0x01U
@@ -42,10 +43,6 @@
 #define HDCP_TRANSACTION_BUFFER_SIZE 635U
 /* Address of DPCD_REV register */
 #define DPCD_DCPD_REV_ADDRESS 0x00000U
-/* Address if device interrupt vector */
-#define DEVICE_SERVICE_IRQ_VECTOR  0x00201U
-/* Mask of 'Content Protection' interrupt */
-#define DEVICE_SERVICE_CP_IRQ_MASK 0x04U
 /* Address of MSTM_CAP register */
 #define MSTM_CAP_ADDRESS 0x00021U
 /* Mask of MST support bit */
@@ -208,8 +205,10 @@ typedef struct {
     bool errorUpdate;
     /* TODO: what is it ? */
     bool customKmEnc;
-    /* If HPD pulse event occurred */
-    bool hpdPulseIrq;
+    /* If CP_IRQ was reported by IRQ_HPD service */
+    bool cpIrq;
+    /* Position of HDCP in ring of HPD events */
+    HpdEventsCursor_t hpdCursor;
     /* Pointer to current SM callback */
     StateCallback_t stateCb;
     /* Structure with pointers to functions of HDCP specified version */
@@ -288,6 +287,12 @@ uint8_t* HDCP_TRAN_getBuffer(void);
  */
 void HDCP_TRAN_initOnReset(void);
 
+/**
+ * Inform HDCP about CP_IRQ, called by IRQ_HPD service after
+ * DEVICE_SERVICE_IRQ_VECTOR is read and acknowledged
+ */
+void HDCP_TRAN_notifyCpIrq(void);
+
 /**
  * Enables or disables fast delays.
  * @param[in] enable, 'true' to set fast delays or 'false'
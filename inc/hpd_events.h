@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * hpd_events.h
+ *
+ ******************************************************************************
+ */
+
+#ifndef HPD_EVENTS_H
+#define HPD_EVENTS_H
+/**
+ *  \file hpd_events.h
+ *  \brief Ring of timestamped HPD events
+ *
+ * Events are put into the ring by HPD interrupt service routine and read
+ * by threads. Ring has a single writer and any number of readers, each
+ * reader keeps its own cursor, so no locking is needed. Reader which is
+ * too slow loses the oldest events, number of lost events is counted.
+ */
+#include "cdn_stdtypes.h"
+
+/* Number of events kept in the ring, must be power of 2 */
+#define HPD_EVENTS_RING_SIZE 16U
+
+/* Types of HPD events, the same values as DP_TX_EVENT_CODE_HPD_* */
+typedef enum {
+    HPD_EVENT_PLUG = 0x01U,
+    HPD_EVENT_UNPLUG = 0x02U,
+    HPD_EVENT_IRQ = 0x04U
+} HpdEventType_t;
+
+/**
+ * Single HPD event
+ */
+typedef struct {
+    /* Value of CCOUNT register when event was detected */
+    uint32_t timestamp;
+    /* Type of event */
+    HpdEventType_t type;
+} HpdEvent_t;
+
+/**
+ * Position of reader in the ring
+ */
+typedef struct {
+    /* Number of events read (or skipped) by reader */
+    uint32_t tail;
+    /* Number of events overwritten before reader read them */
+    uint32_t lost;
+} HpdEventsCursor_t;
+
+/**
+ * Put event into the ring, called from interrupt context only
+ * @param[in] type, type of event
+ */
+void HPD_EVENTS_push(HpdEventType_t type);
+
+/**
+ * Set up reader cursor, only events pushed after this call will be read
+ * @param[out] cursor, cursor of reader
+ */
+void HPD_EVENTS_initCursor(HpdEventsCursor_t* cursor);
+
+/**
+ * Get the oldest event not read by the reader yet
+ * @param[in/out] cursor, cursor of reader
+ * @param[out] event, read event
+ * @return 'true' if event was read or 'false' if there are no new events
+ */
+bool HPD_EVENTS_pop(HpdEventsCursor_t* cursor, HpdEvent_t* event);
+
+#endif /* HPD_EVENTS_H */
@@ -17,6 +17,13 @@
 #define INTERRUPT_H
 
 void interruptInit(void);
+#ifdef USE_SINK_MODEL
+/**
+ * Call interrupt handler from software, used by virtual sink
+ * to deliver AUX and HPD interrupts
+ */
+void interruptRaise(void);
+#endif // USE_SINK_MODEL
 static void HpdEventDetectedIsr(void);
 
 #endif /* INTERRUPT_H */
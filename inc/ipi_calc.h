@@ -30,12 +30,19 @@
 #define IPI_CALC_H
 
 #include "cdn_stdint.h"
+#include "cdn_stdtypes.h"
 
 #define EMPTY_IPI {IPI_POSITIVE_VAL, 0U, NULL}
 
 /** Maximum size allowed for an IPI (in number of limbs). */
 #define CDN_IPI_MAX_LIMBS 10000U
 
+/** Maximum size of window used by exponentiation (1-6). Table of 2^(size-1)
+ *  odd powers, each as large as modulus, is kept during operation. */
+#ifndef IPI_EXP_MAX_WINDOW_SIZE
+#define IPI_EXP_MAX_WINDOW_SIZE 4U
+#endif
+
 /** Used as result of number comparing */
 typedef enum {
     /* Left-hand equals right-hand */
@@ -58,6 +65,18 @@ typedef struct {
     uint32_t* ptr;      /* Pointer to least significant limb */
 } Ipi_t;
 
+/** Precomputed Montgomery context of modulus, used when many
+ *  exponentiations are done with the same modulus */
+typedef struct {
+    /* Modulus, limbs are stored in buffer given by owner of context */
+    Ipi_t N;
+    /* R^2 mod N, limbs are stored in buffer given by owner of context */
+    Ipi_t RR;
+    /* Initialization value of Montgomery multiplication */
+    uint32_t mm;
+    /* 'true' if RR is already calculated */
+    bool isReady;
+} IpiMontCtx_t;
 
 /**
  * Compare signed values
@@ -86,6 +105,21 @@ void ipi_free( Ipi_t *src_ipi );
  */
 uint32_t ipi_rd_binary(Ipi_t *dest_ipi, const uint8_t* srcBuf, uint32_t bufLen);
 
+/**
+ * Import X from unsigned binary data, big endian, into limbs buffer given by caller.
+ * Memory is not allocated, IPI is valid as long as limbs buffer and must not be freed.
+ * Used for keys converted once and kept in limb form.
+ * @param[out] dest_ipi, destination IPI
+ * @param[in] limbs, buffer for limbs
+ * @param[in] limbsNum, size of limbs buffer (in number of limbs)
+ * @param[in] srcBuf, source buffer
+ * @param[in] bufLen, source buffer size
+ * @return CDN_EOK if successful,
+ *         CDN_EINVAL if value equals 0 or limbs buffer is too small
+ */
+uint32_t ipi_rd_binary_static(Ipi_t *dest_ipi, uint32_t* limbs, uint16_t limbsNum,
+                              const uint8_t* srcBuf, uint32_t bufLen);
+
 /**
  * Export X into unsigned binary data, big endian
  * @param[in] src_ipi, pointer to source IPI
@@ -109,4 +143,38 @@ uint32_t ipi_wr_binary( const Ipi_t *src_ipi, uint8_t* destBuf, uint32_t bufLen
  */
 uint32_t ipi_exp_mod( Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, const Ipi_t *N);
 
+/**
+ * Initialize Montgomery context from modulus in unsigned binary data, big endian.
+ * R^2 mod N is calculated during first exponentiation done with context.
+ * @param[out] ctx, pointer to context
+ * @param[in] nLimbs, buffer for limbs of modulus
+ * @param[in] rrLimbs, buffer for limbs of R^2 mod N
+ * @param[in] limbsNum, size of nLimbs and rrLimbs buffers (in number of limbs)
+ * @param[in] srcBuf, source buffer with modulus
+ * @param[in] bufLen, source buffer size
+ * @return CDN_EOK if successful,
+ *         CDN_EINVAL if modulus is even, equals 0 or buffers are too small
+ */
+uint32_t ipi_mont_ctx_init(IpiMontCtx_t* ctx, uint32_t* nLimbs, uint32_t* rrLimbs, uint16_t limbsNum,
+                           const uint8_t* srcBuf, uint32_t bufLen);
+
+/**
+ * Sliding-window exponentiation with precomputed Montgomery context: dest_ipi = A^E mod ctx->N
+ * @param[out] dest_ipi, pointer to destination IPI
+ * @param[in] A, pointer to left-hand IPI
+ * @param[in] E, pointer to exponent IPI
+ * @param[in, out] ctx, pointer to Montgomery context, R^2 mod N is stored there if not ready
+ * @return CDN_EOK if successful,
+ *         CDN_ENOMEM if memory allocation failed,
+ *         CDN_EINVAL if context is not initialized or if E is negative
+ *         CDN_EINPROGRESS if operation is not done yet
+ */
+uint32_t ipi_exp_mod_ctx( Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, IpiMontCtx_t* ctx);
+
+/**
+ * Get memory used by temporaries of the last finished exponentiation
+ * @return peak size of temporaries (in bytes)
+ */
+uint32_t ipi_get_exp_mod_peak_mem(void);
+
 #endif /* IPI_CALC_H */
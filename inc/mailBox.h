@@ -96,6 +96,8 @@ typedef struct
     uint8_t txBuff[MAIL_BOX_MAX_TX_SIZE];
     uint32_t txTotal;
     uint32_t txCur;
+    bool txReserved;
+    uint32_t txReservedIdx;
 } S_MAIL_BOX_DATA;
 
 /* Structure used to store message informations */
@@ -111,6 +113,24 @@ typedef struct {
 uint8_t* MB_GetTxBuff(MB_TYPE type);
 bool MB_IsTxReady(MB_TYPE type);
 void MB_SendMsg(MB_TYPE type, uint32_t len, uint8_t opCode, MB_MODULE_ID moduleId);
+
+/**
+ * Reserve space for message queued after messages which are still being sent.
+ * Other modules see Tx as busy until reserved message is queued.
+ * @param[in] type, type of mailbox
+ * @param[in] len, maximum length of message data
+ * @return pointer to data of reserved message or NULL if there is no space yet
+ */
+uint8_t* MB_ReserveTxMsg(MB_TYPE type, uint32_t len);
+
+/**
+ * Queue message reserved by MB_ReserveTxMsg
+ * @param[in] type, type of mailbox
+ * @param[in] len, length of message data, not greater than reserved
+ * @param[in] opCode, code of operation
+ * @param[in] moduleId, ID of module
+ */
+void MB_QueueTxMsg(MB_TYPE type, uint32_t len, uint8_t opCode, MB_MODULE_ID moduleId);
 bool MB_isWaitingModuleMessage(MB_TYPE type, MB_MODULE_ID moduleId);
 void MB_getCurMessage(MB_TYPE type, uint8_t **message, uint8_t *opCode, uint16_t *msgLen);
 void MB_FinishReadMsg(MB_TYPE type);
@@ -87,10 +87,22 @@ typedef enum
     MODRUNNER_MODULE_SECURE_MAIL_BOX,
     MODRUNNER_MODULE_DP_AUX_TX,
     MODRUNNER_MODULE_DP_AUX_TX_MAIL_HANDLER,
+    MODRUNNER_MODULE_DP_TX_LINK_TRAINING,
+    MODRUNNER_MODULE_DP_TX_SEQUENCER,
+    MODRUNNER_MODULE_DP_TX_LINK_MONITOR,
+    MODRUNNER_MODULE_DP_TX_IRQ,
+    MODRUNNER_MODULE_DP_TX_SNAPSHOT,
     MODRUNNER_MODULE_GENERAL_HANDLER,
 #ifdef USE_TEST_MODULE
     MODRUNNER_TEST_MODULE,
 #endif // USE_TEST_MODULE
+#ifdef USE_SINK_MODEL
+    MODRUNNER_MODULE_SINK_MODEL,
+    MODRUNNER_MODULE_SINK_BENCH,
+#endif // USE_SINK_MODEL
+#ifdef USE_CRYPTO_BENCH
+    MODRUNNER_MODULE_CRYPTO_BENCH,
+#endif // USE_CRYPTO_BENCH
     MODRUNNER_MODULE_LAST
 } MODRUNNER_MODULE_ID;
 
@@ -45,6 +45,10 @@ typedef struct {
 	Buffer_t output;
 	Buffer_t modulus_n;
 	Buffer_t exponent_e;
+	/* Precomputed Montgomery context of modulus, if NULL modulus_n buffer is converted */
+	IpiMontCtx_t* mont_ctx;
+	/* Exponent already in limb form, if NULL exponent_e buffer is converted */
+	const Ipi_t* exponent_ipi;
 } PkcsParam_t;
 
 /**
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * sink_bench.h
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_SINK_MODEL
+
+#ifndef SINK_BENCH_H
+#define SINK_BENCH_H
+/**
+ *  \file sink_bench.h
+ *  \brief AUX benchmark driver, for simulation and benchmarking purpose only
+ *
+ * Driver replays hot-plug sequence (receiver capabilities, link status,
+ * EDID, power state) against virtual sink for number of latency and fault
+ * injection scenarios and reports AUX transaction counts and simulated time.
+ */
+#include "modRunner.h"
+#include "cdn_stdint.h"
+
+/* Number of benchmark scenarios */
+#define SINK_BENCH_SCENARIOS 4U
+
+/**
+ * Result of single benchmark scenario
+ */
+typedef struct {
+    /* Number of completed hot-plug sequences */
+    uint32_t iterations;
+    /* Number of requests finished with less bytes than requested */
+    uint32_t failures;
+    /* Number of native AUX transactions */
+    uint32_t auxTransactions;
+    /* Number of I2C-over-AUX transactions */
+    uint32_t i2cTransactions;
+    /* Number of transactions sent again after DEFER or timeout */
+    uint32_t retries;
+    /* Number of transactions without reply */
+    uint32_t timeouts;
+    /* Time of all sequences in microseconds */
+    uint32_t totalUs;
+    /* Time of the longest sequence in microseconds */
+    uint32_t maxSequenceUs;
+} SinkBenchResult_t;
+
+/**
+ * Get results of benchmark
+ * @return pointer to array of SINK_BENCH_SCENARIOS results
+ */
+const SinkBenchResult_t* SINK_BENCH_getResults(void);
+
+/**
+ * Check if benchmark is finished
+ * @return 'true' if results of all scenarios are ready
+ */
+bool SINK_BENCH_isFinished(void);
+
+/**
+ * Attach module to system
+ */
+void SINK_BENCH_InsertModule(void);
+
+#endif //SINK_BENCH_H
+
+#endif // USE_SINK_MODEL
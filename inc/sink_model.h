@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * sink_model.h
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_SINK_MODEL
+
+#ifndef SINK_MODEL_H
+#define SINK_MODEL_H
+/**
+ *  \file sink_model.h
+ *  \brief virtual DP sink, for simulation and benchmarking purpose only
+ *
+ * Model replaces AUX PHY and sink behind it. It intercepts accesses to AUX
+ * and HPD registers (see CPS_ReadReg32/CPS_WriteReg32), decodes requests
+ * written by DP_TX module, replies from DPCD memory map and EDID I2C slave
+ * and raises AUX interrupts after configured latency.
+ */
+#include "modRunner.h"
+#include "cdn_stdint.h"
+#include "cdn_stdtypes.h"
+
+/* Maximum length of fault injection pattern */
+#define SINK_MODEL_FAULT_PATTERN_LEN 16U
+
+/**
+ * Faults which can be injected into transaction
+ */
+typedef enum {
+    /* Regular reply */
+    SINK_MODEL_FAULT_NONE = 0x00U,
+    /* Reply with AUX_DEFER */
+    SINK_MODEL_FAULT_DEFER = 0x01U,
+    /* Reply with AUX_NACK (I2C_NACK for I2C-over-AUX transactions) */
+    SINK_MODEL_FAULT_NACK = 0x02U,
+    /* No reply, AUX controller reply timer expires */
+    SINK_MODEL_FAULT_TIMEOUT = 0x03U
+} SinkModelFault_t;
+
+/**
+ * Configuration of virtual sink
+ */
+typedef struct {
+    /* Time between end of request and start of reply in microseconds */
+    uint32_t replyLatencyUs;
+    /* Faults applied to consecutive transactions, pattern is repeated */
+    SinkModelFault_t faultPattern[SINK_MODEL_FAULT_PATTERN_LEN];
+    /* Number of used entries in faultPattern, 0 disables fault injection */
+    uint8_t faultPatternLen;
+} SinkModelConfig_t;
+
+/**
+ * Set latency and fault injection pattern, restart pattern from first entry
+ * @param[in] config, new configuration
+ */
+void SINK_MODEL_configure(const SinkModelConfig_t* config);
+
+/**
+ * Connect sink (generates HPD plug event)
+ */
+void SINK_MODEL_plug(void);
+
+/**
+ * Disconnect sink (generates HPD unplug event)
+ */
+void SINK_MODEL_unplug(void);
+
+/**
+ * Generate HPD IRQ pulse
+ */
+void SINK_MODEL_irqHpd(void);
+
+/**
+ * Serve read of register owned by model
+ * @param[in] address, address of register
+ * @param[out] value, value of register
+ * @return 'true' if register is owned by model or 'false' if access should go to hardware
+ */
+bool SINK_MODEL_regRead(const volatile uint32_t* address, uint32_t* value);
+
+/**
+ * Serve write of register owned by model
+ * @param[in] address, address of register
+ * @param[in] value, written value
+ * @return 'true' if register is owned by model or 'false' if access should go to hardware
+ */
+bool SINK_MODEL_regWrite(const volatile uint32_t* address, uint32_t value);
+
+/**
+ * Attach module to system
+ */
+void SINK_MODEL_InsertModule(void);
+
+#endif //SINK_MODEL_H
+
+#endif // USE_SINK_MODEL
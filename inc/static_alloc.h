@@ -53,4 +53,10 @@ uint32_t* malloc_static_ptr32(uint16_t size);
 /** Free a memory block in a static buffer by pointer */
 void free_static_ptr32(const uint32_t *ptr);
 
+/** Return the largest amount of bytes allocated at once (counted in blocks) */
+uint32_t get_max_mem_allocated_static(void);
+
+/** Start new measurement of the largest amount of allocated bytes from current amount */
+void reset_max_mem_allocated_static(void);
+
 #endif // multiple include protection
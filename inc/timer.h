@@ -32,6 +32,26 @@ typedef enum {
     MAILBOX_LINK_LATENCY_TIMER,
     /* Timer used to calculate latency of HDCP2X response */
     HDCP2_RESPONSE_LATENCY_TIMER,
+    /* Timer used to measure duration of link training */
+    DP_TX_LINK_TRAINING_TIMER,
+    /* Timer used to detect timeout of link training request waiting for DP_TX module */
+    DP_TX_LT_WAIT_TIMER,
+    /* Timer used to measure duration of DPCD polling requested by host */
+    DP_TX_POLL_TIMER,
+    /* Timer used to detect timeout of AUX sequence waiting for DP_TX module */
+    DP_TX_SEQ_TIMER,
+    /* Timer used to schedule reads of link status by monitor */
+    DP_TX_LINK_MONITOR_TIMER,
+#ifdef USE_SINK_MODEL
+    /* Timer used by virtual sink to schedule AUX interrupts */
+    SINK_MODEL_TIMER,
+    /* Timer used by benchmark driver to measure hot-plug sequence */
+    SINK_BENCH_TIMER,
+#endif // USE_SINK_MODEL
+#ifdef USE_CRYPTO_BENCH
+    /* Timer used by crypto benchmark driver to measure operations */
+    CRYPTO_BENCH_TIMER,
+#endif // USE_CRYPTO_BENCH
     /* Number of used timers */
     TIMERS_NUMBER
 } Timer_t;
@@ -34,7 +34,6 @@ static CpIrqEvData_t cpIrqEvData;
 static bool cpIrqUsed;
 
 static void processStatusCb(void);
-static void processCpIrq(void);
 static void readStatusCb(void);
 
 void initCpIrqRoutine(void)
@@ -54,39 +53,11 @@ void initCpIrqRoutine(void)
 
 static void waitForCpIrq(void)
 {
-    if (CHANNEL_MASTER_isFree()) {
-
-        /* HPD Pulse event was occurred */
-        if (hdcpGenData.hpdPulseIrq) {
-            hdcpGenData.hpdPulseIrq = false;
-
-            /* Read IRQ vector to check if there's a IRQ for HDCP */
-            CHANNEL_MASTER_read(1U, DEVICE_SERVICE_IRQ_VECTOR, hdcpGenData.hdcpBuffer);
-            cpIrqEvData.cb = &processCpIrq;
-        }
-    }
-}
-
-static void processCpIrq(void)
-{
-    if (CHANNEL_MASTER_isFree()) {
-
-        /* Read CP_IRQ flag */
-        bool cpIrq = (hdcpGenData.hdcpBuffer[0] & (uint8_t)DEVICE_SERVICE_CP_IRQ_MASK) != 0U;
-
-        /* If CP_IRQ occurred, handle it. If not, sleep 1ms and pool again */
-        if (cpIrq) {
-            /* Cleanup CP_IRQ bit */
-            hdcpGenData.hdcpBuffer[0] = (uint8_t)DEVICE_SERVICE_CP_IRQ_MASK;
-            CHANNEL_MASTER_write(1U, DEVICE_SERVICE_IRQ_VECTOR, hdcpGenData.hdcpBuffer);
-
-            cpIrqEvData.cb = &readStatusCb;
-
-        } else {
-            cpIrqEvData.cb = &waitForCpIrq;
-            /* Try again handle interrupt */
-            modRunnerSleep(milliToMicro(CP_IRQ_LATENCY_TIME_MS));
-        }
+    /* CP_IRQ is read from DEVICE_SERVICE_IRQ_VECTOR and acknowledged
+     * by IRQ_HPD service, so status can be read immediately */
+    if (hdcpGenData.cpIrq) {
+        hdcpGenData.cpIrq = false;
+        cpIrqEvData.cb = &readStatusCb;
     }
 }
 
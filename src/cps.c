@@ -18,15 +18,67 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef USE_SINK_MODEL
+#include "sink_model.h"
+#endif // USE_SINK_MODEL
+#ifdef USE_CRYPTO_BENCH
+#include "crypto_model.h"
+#endif // USE_CRYPTO_BENCH
+
+#if defined(USE_SINK_MODEL) || defined(USE_CRYPTO_BENCH)
+/* Serve read of register by simulation model, return 'false' if register is not owned by model */
+static bool modelRegRead(volatile const uint32_t *address, uint32_t *value) {
+    bool served = false;
+#ifdef USE_SINK_MODEL
+    // AUX and HPD registers are served by virtual sink
+    served = SINK_MODEL_regRead(address, value);
+#endif // USE_SINK_MODEL
+#ifdef USE_CRYPTO_BENCH
+    // SHA-256 and AES-32 registers are served by crypto engine model
+    if (!served) {
+        served = CRYPTO_MODEL_regRead(address, value);
+    }
+#endif // USE_CRYPTO_BENCH
+    return served;
+}
+
+/* Serve write of register by simulation model, return 'false' if write should go to hardware */
+static bool modelRegWrite(volatile uint32_t *address, uint32_t value) {
+    bool served = false;
+#ifdef USE_SINK_MODEL
+    served = SINK_MODEL_regWrite(address, value);
+#endif // USE_SINK_MODEL
+#ifdef USE_CRYPTO_BENCH
+    if (!served) {
+        served = CRYPTO_MODEL_regWrite(address, value);
+    }
+#endif // USE_CRYPTO_BENCH
+    return served;
+}
+#endif // USE_SINK_MODEL || USE_CRYPTO_BENCH
 
 /* see cps.h */
 uint32_t CPS_ReadReg32(volatile const uint32_t *address) {
+#if defined(USE_SINK_MODEL) || defined(USE_CRYPTO_BENCH)
+    uint32_t value;
+    if (!modelRegRead(address, &value)) {
+        value = *address;
+    }
+    return value;
+#else
     return *address;
+#endif // USE_SINK_MODEL || USE_CRYPTO_BENCH
 }
 
 /* see cps.h */
 void CPS_WriteReg32(volatile uint32_t *address, uint32_t value) {
+#if defined(USE_SINK_MODEL) || defined(USE_CRYPTO_BENCH)
+    if (!modelRegWrite(address, value)) {
+        *address = value;
+    }
+#else
     *address = value;
+#endif // USE_SINK_MODEL || USE_CRYPTO_BENCH
 }
 
 /* see cps.h */
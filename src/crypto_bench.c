@@ -0,0 +1,644 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * crypto_bench.c
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_CRYPTO_BENCH
+#include "crypto_bench.h"
+#include "ipi_calc.h"
+#include "pkcs1.h"
+#include "sha.h"
+#include "aes.h"
+#include "libHandler.h"
+#include "static_alloc.h"
+#include "timer.h"
+#include "utils.h"
+#include "cdn_errno.h"
+#include "cdn_log.h"
+
+#include <string.h>
+
+/* Number of operations in each scenario */
+#define CRYPTO_BENCH_ITERATIONS 10U
+/* Size of RSA-1024 modulus in bytes */
+#define CRYPTO_BENCH_RSA1024_SIZE 128U
+/* Size of RSA-3072 modulus in bytes */
+#define CRYPTO_BENCH_RSA3072_SIZE 384U
+/* Size of RSA-3072 modulus in limbs */
+#define CRYPTO_BENCH_RSA3072_LIMBS (CRYPTO_BENCH_RSA3072_SIZE / 4U)
+/* Size of public exponent in bytes */
+#define CRYPTO_BENCH_PUBLIC_EXP_SIZE 3U
+/* Size of message encrypted by OAEP (as km of HDCP 2.x) */
+#define CRYPTO_BENCH_OAEP_MESSAGE_SIZE 16U
+/* Size of message authenticated by HMAC and encrypted by AES */
+#define CRYPTO_BENCH_MESSAGE_SIZE 256U
+/* Size of HMAC key */
+#define CRYPTO_BENCH_HMAC_KEY_SIZE 32U
+
+/**
+ * Single benchmark scenario
+ */
+typedef struct {
+    /* Name used in report */
+    const char* name;
+    /* Prepare operation (not measured), returns CDN_EOK if succeeded */
+    uint32_t (*prepare)(void);
+    /* Do step of operation, returns CDN_EINPROGRESS if operation is not finished */
+    uint32_t (*step)(void);
+    /* Check result of finished operation and release its data, returns 'true' if result is correct */
+    bool (*finish)(uint32_t retVal);
+} CryptoBenchScenario_t;
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* Index of current scenario */
+    uint8_t scenario;
+    /* Number of finished operations in current scenario */
+    uint32_t iteration;
+    /* Base of exponentiation */
+    Ipi_t A;
+    /* Exponent */
+    Ipi_t E;
+    /* Modulus */
+    Ipi_t N;
+    /* Result of exponentiation */
+    Ipi_t R;
+    /* Expected result of exponentiation, NULL if not checked */
+    const uint8_t* expected;
+    /* Size of modulus in bytes */
+    uint32_t size;
+    /* Parameters of PKCS#1 operations */
+    PkcsParam_t pkcsParams;
+    /* Montgomery context of RSA-3072 key, kept as for DCP LLC key */
+    IpiMontCtx_t montCtx;
+    /* Limbs of modulus in Montgomery context */
+    uint32_t modulusLimbs[CRYPTO_BENCH_RSA3072_LIMBS];
+    /* Limbs of R^2 mod N in Montgomery context */
+    uint32_t rrLimbs[CRYPTO_BENCH_RSA3072_LIMBS];
+    /* Limb of public exponent */
+    uint32_t exponentLimb;
+    /* Public exponent in limb form, kept as for DCP LLC key */
+    Ipi_t exponentIpi;
+    /* Output of operations */
+    uint8_t output[CRYPTO_BENCH_RSA3072_SIZE];
+    /* Input of HMAC, AES and OAEP */
+    uint8_t message[CRYPTO_BENCH_MESSAGE_SIZE];
+    /* Results of scenarios */
+    CryptoBenchResult_t results[CRYPTO_BENCH_SCENARIOS];
+} CryptoBenchData_t;
+
+static CryptoBenchData_t cryptoBenchData;
+
+/* Test vectors, RSA keys are generated only for benchmark */
+
+/* Public exponent of both keys */
+static uint8_t publicExp[CRYPTO_BENCH_PUBLIC_EXP_SIZE] = { 0x01U, 0x00U, 0x01U };
+
+/* RSA-1024 key: modulus */
+static uint8_t modulus1024[128] = {
+    0xB0U, 0xB2U, 0x3DU, 0xA5U, 0xFBU, 0xB4U, 0xC6U, 0xA4U, 0xCDU, 0x84U, 0x88U, 0x5BU,
+    0x32U, 0xD8U, 0x9CU, 0x2AU, 0x82U, 0x81U, 0x69U, 0x8BU, 0xFBU, 0x46U, 0x69U, 0x7FU,
+    0x77U, 0xC6U, 0xFAU, 0x11U, 0xAEU, 0xE9U, 0xCBU, 0xDCU, 0x57U, 0x37U, 0xE8U, 0x1AU,
+    0x96U, 0xD0U, 0x8BU, 0x95U, 0xF0U, 0x4DU, 0xC3U, 0x9DU, 0xF6U, 0xA6U, 0x71U, 0xAFU,
+    0x51U, 0x32U, 0x6DU, 0x5DU, 0xBCU, 0x91U, 0x7BU, 0xB7U, 0x1CU, 0x7FU, 0xF1U, 0x70U,
+    0x12U, 0x11U, 0xC3U, 0xC0U, 0xF4U, 0x96U, 0xB2U, 0xE7U, 0xEBU, 0xA5U, 0x0BU, 0xD4U,
+    0xDDU, 0xADU, 0xC9U, 0xC1U, 0x38U, 0x40U, 0x93U, 0x00U, 0x37U, 0x66U, 0x51U, 0x78U,
+    0x98U, 0xB4U, 0x97U, 0x3BU, 0x6EU, 0x79U, 0x8EU, 0x32U, 0x14U, 0x7FU, 0xD3U, 0x96U,
+    0x8AU, 0xA0U, 0x7CU, 0x49U, 0xE2U, 0x13U, 0x6DU, 0x5CU, 0x60U, 0x8EU, 0x95U, 0x07U,
+    0xA4U, 0x4DU, 0x46U, 0x65U, 0x53U, 0x48U, 0x19U, 0x79U, 0x1AU, 0x78U, 0x1CU, 0x7EU,
+    0x9CU, 0x81U, 0x6BU, 0x91U, 0x90U, 0xE3U, 0xF0U, 0xB7U
+};
+
+/* RSA-1024 key: private exponent */
+static const uint8_t privateExp1024[128] = {
+    0x99U, 0xBDU, 0x1CU, 0x02U, 0x95U, 0x74U, 0xFEU, 0xF9U, 0x59U, 0x90U, 0x1DU, 0x0CU,
+    0x2CU, 0xBBU, 0x67U, 0x75U, 0x5DU, 0x43U, 0xB8U, 0x50U, 0x01U, 0x7BU, 0x8CU, 0x43U,
+    0x4AU, 0x36U, 0x28U, 0x52U, 0xC6U, 0x7BU, 0xC9U, 0xD2U, 0x97U, 0x58U, 0x9FU, 0x6CU,
+    0xB3U, 0x18U, 0x14U, 0xBBU, 0x8AU, 0xF0U, 0x3EU, 0x69U, 0xECU, 0xB7U, 0x79U, 0x66U,
+    0xEFU, 0x21U, 0x0FU, 0x23U, 0x65U, 0xF4U, 0xB7U, 0x4DU, 0xE5U, 0x50U, 0x35U, 0x04U,
+    0x2BU, 0xD4U, 0xA5U, 0x1AU, 0x86U, 0x1AU, 0x7AU, 0x3DU, 0x45U, 0xD8U, 0xBDU, 0x88U,
+    0xD4U, 0x9CU, 0x54U, 0xC0U, 0x69U, 0xA3U, 0xA4U, 0x84U, 0x71U, 0x7FU, 0x1BU, 0xACU,
+    0x9BU, 0xF4U, 0xB4U, 0xE5U, 0x8FU, 0x77U, 0xFDU, 0xD9U, 0xC7U, 0xE8U, 0xC2U, 0xCFU,
+    0x31U, 0x12U, 0xAEU, 0xEBU, 0x40U, 0xEBU, 0x36U, 0xEBU, 0x14U, 0xF6U, 0x3AU, 0xB1U,
+    0x7CU, 0xA7U, 0x89U, 0x3DU, 0x1BU, 0xCBU, 0xEDU, 0xC6U, 0x97U, 0x00U, 0x3DU, 0xC9U,
+    0xC8U, 0x55U, 0x7AU, 0x1CU, 0x38U, 0x33U, 0xE9U, 0x91U
+};
+
+/* Message representative, X */
+static const uint8_t message1024[128] = {
+    0x0CU, 0xD3U, 0xD9U, 0xB4U, 0xF5U, 0x6CU, 0xADU, 0x87U, 0x00U, 0xF3U, 0xBCU, 0xDAU,
+    0xC5U, 0x58U, 0xCEU, 0x75U, 0xFDU, 0x21U, 0x7EU, 0x4EU, 0x0CU, 0x84U, 0xD0U, 0x4CU,
+    0xE0U, 0xDCU, 0x30U, 0x90U, 0xE2U, 0x0CU, 0xC9U, 0x62U, 0xFFU, 0x44U, 0xA0U, 0x91U,
+    0x6AU, 0x85U, 0xCEU, 0xE3U, 0x4FU, 0xD0U, 0x7EU, 0x3EU, 0x18U, 0xD7U, 0x8CU, 0x6EU,
+    0x29U, 0xC6U, 0x03U, 0xF0U, 0xB5U, 0x25U, 0xCBU, 0xE6U, 0x7BU, 0xC8U, 0xBFU, 0xE8U,
+    0x26U, 0x15U, 0xE3U, 0x05U, 0x3CU, 0xEDU, 0x4AU, 0xFEU, 0xEDU, 0x3DU, 0x70U, 0x5AU,
+    0x7AU, 0x6EU, 0x61U, 0x40U, 0xBBU, 0xEDU, 0x09U, 0x7DU, 0x0DU, 0xB0U, 0x16U, 0x93U,
+    0x54U, 0xC0U, 0x08U, 0x65U, 0xE5U, 0x5BU, 0x2AU, 0xD1U, 0x41U, 0xF6U, 0x45U, 0x96U,
+    0x60U, 0x4BU, 0x84U, 0x7FU, 0x70U, 0xDDU, 0x59U, 0x44U, 0x65U, 0x11U, 0x69U, 0xD8U,
+    0x2DU, 0x74U, 0x90U, 0x67U, 0x7DU, 0x1BU, 0x3EU, 0xD1U, 0x86U, 0xA7U, 0xC0U, 0xC0U,
+    0xA8U, 0x5EU, 0xF7U, 0xDBU, 0x28U, 0xDDU, 0x40U, 0x8FU
+};
+
+/* Signature representative, X^d mod N */
+static const uint8_t signature1024[128] = {
+    0x4FU, 0xA2U, 0x81U, 0x75U, 0x89U, 0xE7U, 0xCDU, 0x59U, 0x6FU, 0x1DU, 0x91U, 0x94U,
+    0x23U, 0x52U, 0xB2U, 0x4BU, 0xD9U, 0x24U, 0x91U, 0xB5U, 0x19U, 0x40U, 0x35U, 0xB6U,
+    0xAFU, 0x60U, 0xC4U, 0x7CU, 0x4CU, 0x04U, 0x5EU, 0xD4U, 0xF6U, 0xC3U, 0x7EU, 0x32U,
+    0x2FU, 0xA3U, 0x69U, 0x53U, 0xE0U, 0xE5U, 0x6CU, 0xBCU, 0x1FU, 0x8BU, 0x05U, 0x42U,
+    0x43U, 0x52U, 0x90U, 0xCAU, 0xCEU, 0x1BU, 0x28U, 0x01U, 0x79U, 0xE9U, 0x47U, 0xEAU,
+    0xFEU, 0x3FU, 0xF5U, 0xE6U, 0x45U, 0x07U, 0xDCU, 0x8DU, 0x7AU, 0x36U, 0x66U, 0x13U,
+    0xA0U, 0x28U, 0xAEU, 0x82U, 0x4BU, 0x6BU, 0x4AU, 0x3FU, 0x3CU, 0xBBU, 0x05U, 0x93U,
+    0x69U, 0x3AU, 0x79U, 0xEFU, 0xB3U, 0xE9U, 0xFFU, 0x4EU, 0x3FU, 0x7CU, 0xB6U, 0x1BU,
+    0xE2U, 0x9EU, 0xD6U, 0x00U, 0xD7U, 0xB4U, 0x56U, 0x68U, 0xB8U, 0x55U, 0x6DU, 0x07U,
+    0x2DU, 0x98U, 0x5CU, 0x43U, 0xF3U, 0x3AU, 0xD4U, 0x0EU, 0x82U, 0x9DU, 0xB7U, 0x1DU,
+    0xC6U, 0x78U, 0xCAU, 0x35U, 0x67U, 0xBAU, 0x3EU, 0xAFU
+};
+
+/* RSA-3072 key: modulus */
+static uint8_t modulus3072[384] = {
+    0xCFU, 0xE7U, 0xA9U, 0xBFU, 0xA5U, 0x9AU, 0xDBU, 0x64U, 0x91U, 0xE1U, 0x1DU, 0xF7U,
+    0x78U, 0x4DU, 0x98U, 0x2BU, 0xFBU, 0xAEU, 0x3EU, 0x94U, 0x78U, 0x06U, 0x0CU, 0x35U,
+    0x8AU, 0x4DU, 0x62U, 0x81U, 0x11U, 0x49U, 0x34U, 0xA7U, 0x2FU, 0x19U, 0xF5U, 0xC2U,
+    0xB6U, 0xE5U, 0xF3U, 0x95U, 0xE7U, 0x63U, 0x2CU, 0x67U, 0x2EU, 0x71U, 0xE8U, 0x22U,
+    0x0FU, 0x1BU, 0xF0U, 0xD0U, 0x1BU, 0x22U, 0x84U, 0x37U, 0xFEU, 0x80U, 0x9AU, 0x74U,
+    0x59U, 0x85U, 0xA6U, 0xBFU, 0xD5U, 0x08U, 0x09U, 0xDEU, 0x61U, 0xE8U, 0x4AU, 0x82U,
+    0x81U, 0xD2U, 0x63U, 0x3FU, 0xF6U, 0xF8U, 0x10U, 0x6EU, 0x2BU, 0x39U, 0x85U, 0x44U,
+    0xBCU, 0x9CU, 0x18U, 0x7FU, 0x1CU, 0x5AU, 0xDAU, 0x29U, 0x7EU, 0xDBU, 0x05U, 0xABU,
+    0xC6U, 0xEEU, 0x5EU, 0x19U, 0x21U, 0xB3U, 0x7DU, 0x33U, 0x38U, 0xB9U, 0xEBU, 0xBDU,
+    0x62U, 0x55U, 0x1FU, 0x77U, 0xE8U, 0xD3U, 0xB6U, 0xDEU, 0x9FU, 0xE3U, 0x7DU, 0x72U,
+    0x3CU, 0x44U, 0xDFU, 0x5AU, 0x48U, 0xF0U, 0x1DU, 0xBCU, 0x0CU, 0xD8U, 0x30U, 0x14U,
+    0x9FU, 0x8DU, 0x4EU, 0x20U, 0x31U, 0xDAU, 0x69U, 0x29U, 0xACU, 0xD4U, 0xBFU, 0xC5U,
+    0x24U, 0x9FU, 0x0BU, 0x34U, 0x3AU, 0xC9U, 0xB4U, 0x50U, 0x5BU, 0x82U, 0x14U, 0xFBU,
+    0x4BU, 0xADU, 0xADU, 0x72U, 0xB9U, 0xF0U, 0x9FU, 0x6DU, 0x8BU, 0x45U, 0x11U, 0x8EU,
+    0x36U, 0x52U, 0xA7U, 0x8FU, 0xF3U, 0x81U, 0x8CU, 0x2FU, 0x85U, 0xA6U, 0xA3U, 0x5DU,
+    0xA6U, 0x22U, 0x57U, 0x79U, 0x0DU, 0x81U, 0xCAU, 0x5FU, 0x2AU, 0x61U, 0xB3U, 0x17U,
+    0xF8U, 0xF9U, 0x5FU, 0x6AU, 0xBEU, 0x65U, 0x68U, 0xC6U, 0x1EU, 0xFCU, 0x4BU, 0x96U,
+    0x75U, 0xAAU, 0x2EU, 0x99U, 0x7DU, 0x84U, 0xE7U, 0x8AU, 0x80U, 0x93U, 0xF7U, 0x46U,
+    0x93U, 0x6FU, 0x6CU, 0x8CU, 0x24U, 0xDCU, 0x49U, 0xDEU, 0x09U, 0x84U, 0x12U, 0xD7U,
+    0x58U, 0x58U, 0xA8U, 0xAAU, 0x0DU, 0x88U, 0x9BU, 0xFEU, 0xE9U, 0x30U, 0xDEU, 0xF4U,
+    0xF2U, 0xC0U, 0x77U, 0x86U, 0xACU, 0xA5U, 0x74U, 0x68U, 0x11U, 0x4CU, 0xFEU, 0xB2U,
+    0xD9U, 0x80U, 0x65U, 0x16U, 0xA6U, 0xECU, 0xF6U, 0x70U, 0x76U, 0xFDU, 0x1EU, 0x9FU,
+    0x24U, 0x14U, 0xD4U, 0x6AU, 0x66U, 0x5CU, 0x0BU, 0xB7U, 0xEEU, 0x37U, 0x9FU, 0xF4U,
+    0xD7U, 0x13U, 0xC0U, 0x3CU, 0x7CU, 0x65U, 0xC9U, 0x59U, 0x96U, 0x5DU, 0x11U, 0xF5U,
+    0xA7U, 0x52U, 0x16U, 0x1DU, 0xD3U, 0x99U, 0x0FU, 0x24U, 0x81U, 0xEAU, 0xDBU, 0xC4U,
+    0x08U, 0xD2U, 0x63U, 0xDAU, 0x72U, 0x96U, 0x16U, 0x1CU, 0xCEU, 0x57U, 0xF8U, 0x35U,
+    0x21U, 0xA6U, 0x0AU, 0x63U, 0x88U, 0x8AU, 0xD9U, 0xD5U, 0xB4U, 0xD0U, 0x05U, 0xFBU,
+    0xC7U, 0xAAU, 0x9CU, 0x6DU, 0xCBU, 0xFBU, 0x1EU, 0xE6U, 0x58U, 0xF7U, 0x67U, 0xCAU,
+    0x84U, 0x4BU, 0xD7U, 0x07U, 0x0EU, 0x02U, 0xAFU, 0x73U, 0x89U, 0x0FU, 0xFFU, 0x19U,
+    0xB6U, 0x12U, 0xCCU, 0x01U, 0x12U, 0x25U, 0x35U, 0x96U, 0xD6U, 0x0FU, 0x81U, 0x56U,
+    0xD6U, 0x81U, 0x17U, 0xD6U, 0x6AU, 0x5CU, 0x74U, 0x7BU, 0x85U, 0xDBU, 0x5EU, 0xC5U,
+    0x15U, 0xECU, 0x37U, 0xEFU, 0xA6U, 0x0EU, 0x72U, 0xD4U, 0x28U, 0x7BU, 0x85U, 0xAFU
+};
+
+/* PKCS#1 v1.5 signature of SHA-256 hash below */
+static uint8_t signature3072[384] = {
+    0x8DU, 0xE4U, 0x4BU, 0xD9U, 0xE4U, 0xA1U, 0xECU, 0xD8U, 0x8DU, 0xCAU, 0xBAU, 0xADU,
+    0x9CU, 0xD2U, 0x4DU, 0xA1U, 0x68U, 0x40U, 0x00U, 0x17U, 0x9DU, 0x00U, 0x2BU, 0x24U,
+    0x04U, 0x38U, 0x12U, 0x5BU, 0x4AU, 0x8AU, 0xB3U, 0x55U, 0x6AU, 0x40U, 0xB9U, 0xFBU,
+    0xA1U, 0xE9U, 0xB8U, 0x26U, 0xC9U, 0xE0U, 0x15U, 0x8AU, 0x8FU, 0xE4U, 0xD6U, 0x01U,
+    0xCEU, 0x6BU, 0xE1U, 0xEEU, 0xA7U, 0xB2U, 0x7AU, 0xE2U, 0x08U, 0x2EU, 0xD1U, 0x9DU,
+    0x08U, 0x7AU, 0x13U, 0x5EU, 0xDBU, 0xAFU, 0x39U, 0x01U, 0x57U, 0x12U, 0x12U, 0xF0U,
+    0x98U, 0xBEU, 0xE0U, 0x7EU, 0xDFU, 0x1FU, 0xE7U, 0x2AU, 0x37U, 0x0FU, 0x6EU, 0xFBU,
+    0x92U, 0x48U, 0x42U, 0xB2U, 0x0AU, 0x3EU, 0x55U, 0x04U, 0xF3U, 0x6BU, 0x10U, 0x18U,
+    0x24U, 0xBAU, 0xEAU, 0x07U, 0x79U, 0x57U, 0x59U, 0x96U, 0xE3U, 0xBEU, 0x8FU, 0x46U,
+    0x43U, 0x0BU, 0xC9U, 0x12U, 0xC2U, 0x43U, 0xFFU, 0xDBU, 0xFDU, 0xD9U, 0x6EU, 0x9DU,
+    0x45U, 0x5BU, 0xDFU, 0x2BU, 0xFDU, 0x5CU, 0x7DU, 0xDCU, 0xDEU, 0x4DU, 0x0AU, 0x3AU,
+    0xF7U, 0x88U, 0x24U, 0xD2U, 0x10U, 0xFEU, 0xBEU, 0xB2U, 0x0FU, 0x07U, 0x67U, 0x2EU,
+    0xAFU, 0x34U, 0x4EU, 0xA8U, 0x0BU, 0x70U, 0x47U, 0x00U, 0x1EU, 0x20U, 0xB7U, 0x64U,
+    0xE5U, 0x6FU, 0x12U, 0xE5U, 0x4BU, 0xB8U, 0x46U, 0x2DU, 0x9BU, 0xFCU, 0x17U, 0x33U,
+    0xAFU, 0xC0U, 0xC8U, 0x06U, 0x41U, 0x57U, 0xF5U, 0x13U, 0xFCU, 0xD7U, 0x1EU, 0x26U,
+    0xB7U, 0x0DU, 0xC9U, 0x42U, 0x51U, 0x35U, 0xCFU, 0x15U, 0x3BU, 0xA1U, 0x49U, 0xC5U,
+    0x70U, 0x58U, 0x2AU, 0x0EU, 0xD4U, 0x62U, 0xAFU, 0x28U, 0x28U, 0x85U, 0xF5U, 0x6EU,
+    0x94U, 0xF4U, 0xC4U, 0xACU, 0x76U, 0x64U, 0x47U, 0xC8U, 0xDCU, 0x19U, 0xD5U, 0x05U,
+    0x1EU, 0xC9U, 0x23U, 0x75U, 0x93U, 0x0BU, 0xE4U, 0x8FU, 0xF3U, 0xC0U, 0x33U, 0x1FU,
+    0x6AU, 0xB5U, 0x50U, 0x66U, 0xC7U, 0x95U, 0x0CU, 0xADU, 0x46U, 0x93U, 0x46U, 0xE6U,
+    0xBEU, 0x0EU, 0xD1U, 0x4FU, 0x48U, 0x35U, 0x69U, 0x9BU, 0xA6U, 0xD7U, 0xFEU, 0xD8U,
+    0xF1U, 0xFDU, 0x7EU, 0x86U, 0xA2U, 0x20U, 0xF5U, 0xBBU, 0x3DU, 0x07U, 0xC0U, 0xFEU,
+    0x78U, 0x3CU, 0x35U, 0x3CU, 0x36U, 0x4DU, 0xE3U, 0xBDU, 0xE3U, 0xE5U, 0x88U, 0xC2U,
+    0xBAU, 0x63U, 0x8DU, 0xB5U, 0x7DU, 0x91U, 0xADU, 0xEAU, 0x8BU, 0x05U, 0x56U, 0x44U,
+    0x8CU, 0x11U, 0x71U, 0xF4U, 0xD9U, 0x8AU, 0x85U, 0x33U, 0xDCU, 0x7AU, 0xA5U, 0x25U,
+    0xC6U, 0xF5U, 0xE2U, 0xB2U, 0xCFU, 0xA4U, 0x2CU, 0xAFU, 0x2AU, 0xE5U, 0x90U, 0x1DU,
+    0x7AU, 0xE6U, 0x2AU, 0x6CU, 0x7BU, 0x41U, 0x16U, 0x49U, 0x3CU, 0x17U, 0xA6U, 0xEAU,
+    0x24U, 0x76U, 0x80U, 0xBCU, 0x3CU, 0xCEU, 0x28U, 0x48U, 0x7AU, 0x14U, 0xF0U, 0x4FU,
+    0x13U, 0x77U, 0x33U, 0x19U, 0x04U, 0xDDU, 0x6BU, 0xBAU, 0xBBU, 0x4DU, 0x07U, 0xD8U,
+    0x7DU, 0xD8U, 0x9AU, 0xAAU, 0x4FU, 0x42U, 0x81U, 0xBDU, 0x72U, 0xEEU, 0x3BU, 0xFAU,
+    0x99U, 0xF3U, 0xA8U, 0x15U, 0xA6U, 0x73U, 0xD1U, 0xE1U, 0xB8U, 0x8AU, 0xE7U, 0xA7U,
+    0x70U, 0x87U, 0x61U, 0x8CU, 0xA1U, 0xD9U, 0x4AU, 0xB9U, 0xD6U, 0x78U, 0x9CU, 0xECU
+};
+
+/* Signed SHA-256 hash */
+static const uint8_t hash3072[32] = {
+    0x74U, 0x62U, 0x8CU, 0xBAU, 0x1AU, 0xD8U, 0xEBU, 0x24U, 0x80U, 0x0CU, 0x4DU, 0xB6U,
+    0x6AU, 0xCEU, 0x02U, 0x1BU, 0xB7U, 0x13U, 0x76U, 0xADU, 0x42U, 0x16U, 0x14U, 0x1BU,
+    0x7CU, 0x43U, 0x23U, 0xC0U, 0xF1U, 0x88U, 0x32U, 0x91U
+};
+
+/* HMAC key */
+static const uint8_t hmacKey[32] = {
+    0x40U, 0x41U, 0x42U, 0x43U, 0x44U, 0x45U, 0x46U, 0x47U, 0x48U, 0x49U, 0x4AU, 0x4BU,
+    0x4CU, 0x4DU, 0x4EU, 0x4FU, 0x50U, 0x51U, 0x52U, 0x53U, 0x54U, 0x55U, 0x56U, 0x57U,
+    0x58U, 0x59U, 0x5AU, 0x5BU, 0x5CU, 0x5DU, 0x5EU, 0x5FU
+};
+
+/* Expected HMAC-SHA256 of message (bytes 0x00-0xFF) */
+static const uint8_t hmacExpected[32] = {
+    0xAEU, 0x22U, 0xE7U, 0xBFU, 0x63U, 0x99U, 0x3AU, 0xDDU, 0x90U, 0xEFU, 0x22U, 0x44U,
+    0xF8U, 0x49U, 0x3FU, 0x7AU, 0xD5U, 0x88U, 0xF1U, 0x21U, 0x42U, 0x55U, 0x25U, 0xDAU,
+    0x8AU, 0x92U, 0x24U, 0x33U, 0x73U, 0x15U, 0x63U, 0x95U
+};
+
+/* Expected AES-128 ciphertext of first message block (bytes 0x00-0x0F), key is first bytes of HMAC key */
+static const uint8_t aesExpected[AES_CRYPT_DATA_SIZE_IN_BYTES] = {
+    0x3DU, 0x0FU, 0xA4U, 0xB8U, 0x55U, 0xD2U, 0xA5U, 0xAAU, 0x49U, 0x54U, 0xB8U, 0xB5U,
+    0xDFU, 0x58U, 0x2AU, 0x3AU
+};
+
+static void startScenarioHandler(void);
+static void startOperationHandler(void);
+static void operationHandler(void);
+
+/**
+ * Update peak memory of exponentiation temporaries in result of current scenario
+ */
+static void updateExpModPeakMem(void)
+{
+    CryptoBenchResult_t* result = &cryptoBenchData.results[cryptoBenchData.scenario];
+    uint32_t peakMem = ipi_get_exp_mod_peak_mem();
+
+    if (peakMem > result->expModPeakMem) {
+        result->expModPeakMem = peakMem;
+    }
+}
+
+/**
+ * Convert operands of exponentiation
+ * @param[in] base, base in big-endian order
+ * @param[in] exponent, exponent in big-endian order
+ * @param[in] expSize, size of exponent in bytes
+ * @param[in] modulus, modulus in big-endian order
+ * @param[in] size, size of base and modulus in bytes
+ * @param[in] expected, expected result or NULL if result is not checked
+ * @return CDN_EOK if success
+ */
+static uint32_t prepareExpMod(const uint8_t* base, const uint8_t* exponent, uint32_t expSize,
+                              const uint8_t* modulus, uint32_t size, const uint8_t* expected)
+{
+    uint32_t retVal;
+
+    retVal  = ipi_rd_binary(&cryptoBenchData.A, base, size);
+    retVal |= ipi_rd_binary(&cryptoBenchData.E, exponent, expSize);
+    retVal |= ipi_rd_binary(&cryptoBenchData.N, modulus, size);
+
+    cryptoBenchData.expected = expected;
+    cryptoBenchData.size = size;
+
+    return retVal;
+}
+
+/** Prepare RSA-1024 public key operation: signature^e mod N = message */
+static uint32_t prepareExp1024Public(void)
+{
+    return prepareExpMod(signature1024, publicExp, CRYPTO_BENCH_PUBLIC_EXP_SIZE,
+                         modulus1024, CRYPTO_BENCH_RSA1024_SIZE, message1024);
+}
+
+/** Prepare RSA-1024 private key operation: message^d mod N = signature */
+static uint32_t prepareExp1024Private(void)
+{
+    return prepareExpMod(message1024, privateExp1024, CRYPTO_BENCH_RSA1024_SIZE,
+                         modulus1024, CRYPTO_BENCH_RSA1024_SIZE, signature1024);
+}
+
+/** Prepare RSA-3072 public key operation, result is checked by verify scenario */
+static uint32_t prepareExp3072Public(void)
+{
+    return prepareExpMod(signature3072, publicExp, CRYPTO_BENCH_PUBLIC_EXP_SIZE,
+                         modulus3072, CRYPTO_BENCH_RSA3072_SIZE, NULL);
+}
+
+/** Do step of exponentiation */
+static uint32_t stepExpMod(void)
+{
+    return ipi_exp_mod(&cryptoBenchData.R, &cryptoBenchData.A, &cryptoBenchData.E, &cryptoBenchData.N);
+}
+
+/** Check result of exponentiation and release operands */
+static bool finishExpMod(uint32_t retVal)
+{
+    bool isCorrect = (retVal == CDN_EOK);
+
+    if (isCorrect && (cryptoBenchData.expected != NULL)) {
+        isCorrect = (ipi_wr_binary(&cryptoBenchData.R, cryptoBenchData.output, cryptoBenchData.size) == CDN_EOK)
+                    && (memcmp(cryptoBenchData.output, cryptoBenchData.expected, cryptoBenchData.size) == 0);
+    }
+
+    ipi_free(&cryptoBenchData.A);
+    ipi_free(&cryptoBenchData.E);
+    ipi_free(&cryptoBenchData.N);
+    ipi_free(&cryptoBenchData.R);
+
+    updateExpModPeakMem();
+
+    return isCorrect;
+}
+
+/** Prepare PKCS#1 v1.5 signature verification with RSA-3072 key */
+static uint32_t prepareVerify(void)
+{
+    PkcsParam_t* params = &cryptoBenchData.pkcsParams;
+
+    set_pkcs_parameter(&params->input, signature3072, CRYPTO_BENCH_RSA3072_SIZE);
+    set_pkcs_parameter(&params->output, cryptoBenchData.output, CRYPTO_BENCH_RSA3072_SIZE);
+    set_pkcs_parameter(&params->modulus_n, modulus3072, CRYPTO_BENCH_RSA3072_SIZE);
+    set_pkcs_parameter(&params->exponent_e, publicExp, CRYPTO_BENCH_PUBLIC_EXP_SIZE);
+    params->mont_ctx = &cryptoBenchData.montCtx;
+    params->exponent_ipi = &cryptoBenchData.exponentIpi;
+
+    return CDN_EOK;
+}
+
+/** Do step of signature verification */
+static uint32_t stepVerify(void)
+{
+    return pkcs1_v15_rsassa_verify(&cryptoBenchData.pkcsParams, hash3072);
+}
+
+/** Prepare PKCS#1 OAEP encryption with RSA-1024 key */
+static uint32_t prepareEncrypt(void)
+{
+    PkcsParam_t* params = &cryptoBenchData.pkcsParams;
+
+    set_pkcs_parameter(&params->input, cryptoBenchData.message, CRYPTO_BENCH_OAEP_MESSAGE_SIZE);
+    set_pkcs_parameter(&params->output, cryptoBenchData.output, CRYPTO_BENCH_RSA1024_SIZE);
+    set_pkcs_parameter(&params->modulus_n, modulus1024, CRYPTO_BENCH_RSA1024_SIZE);
+    set_pkcs_parameter(&params->exponent_e, publicExp, CRYPTO_BENCH_PUBLIC_EXP_SIZE);
+    params->mont_ctx = NULL;
+    params->exponent_ipi = NULL;
+
+    return CDN_EOK;
+}
+
+/** Do step of OAEP encryption */
+static uint32_t stepEncrypt(void)
+{
+    return pkcs1_rsaes_oaep_encrypt(&cryptoBenchData.pkcsParams);
+}
+
+/** Check result of PKCS#1 operation */
+static bool finishPkcs(uint32_t retVal)
+{
+    updateExpModPeakMem();
+
+    return (retVal == CDN_EOK);
+}
+
+/** Nothing to prepare */
+static uint32_t prepareNone(void)
+{
+    return CDN_EOK;
+}
+
+/** Calculate HMAC-SHA256 of message */
+static uint32_t stepHmac(void)
+{
+    sha256_hmac(hmacKey, CRYPTO_BENCH_HMAC_KEY_SIZE, cryptoBenchData.message, CRYPTO_BENCH_MESSAGE_SIZE,
+                cryptoBenchData.output);
+
+    return CDN_EOK;
+}
+
+/** Check HMAC-SHA256 of message */
+static bool finishHmac(uint32_t retVal)
+{
+    return (retVal == CDN_EOK) && (memcmp(cryptoBenchData.output, hmacExpected, SHA256_HASH_SIZE_IN_BYTES) == 0);
+}
+
+/** Set AES key, first bytes of HMAC key are used */
+static uint32_t prepareAes(void)
+{
+    aes_setkey(hmacKey);
+
+    return CDN_EOK;
+}
+
+/** Encrypt message block by block */
+static uint32_t stepAes(void)
+{
+    uint32_t offset;
+
+    for (offset = 0U; offset < CRYPTO_BENCH_MESSAGE_SIZE; offset += AES_CRYPT_DATA_SIZE_IN_BYTES) {
+        aes_crypt(&cryptoBenchData.message[offset], &cryptoBenchData.output[offset]);
+    }
+
+    return CDN_EOK;
+}
+
+/** Check first encrypted block */
+static bool finishAes(uint32_t retVal)
+{
+    return (retVal == CDN_EOK) && (memcmp(cryptoBenchData.output, aesExpected, AES_CRYPT_DATA_SIZE_IN_BYTES) == 0);
+}
+
+/* Scenarios done in order */
+static const CryptoBenchScenario_t scenarios[CRYPTO_BENCH_SCENARIOS] = {
+    { "exp_mod 1024 (e = 65537)", &prepareExp1024Public, &stepExpMod, &finishExpMod },
+    { "exp_mod 1024 (private exponent)", &prepareExp1024Private, &stepExpMod, &finishExpMod },
+    { "exp_mod 3072 (e = 65537)", &prepareExp3072Public, &stepExpMod, &finishExpMod },
+    { "pkcs1_v15_rsassa_verify 3072", &prepareVerify, &stepVerify, &finishPkcs },
+    { "pkcs1_rsaes_oaep_encrypt 1024", &prepareEncrypt, &stepEncrypt, &finishPkcs },
+    { "HMAC-SHA256 256 B", &prepareNone, &stepHmac, &finishHmac },
+    { "AES 256 B", &prepareAes, &stepAes, &finishAes },
+};
+
+/**
+ * Print result of current scenario
+ */
+static void printScenarioResult(void)
+{
+    const CryptoBenchResult_t* result = &cryptoBenchData.results[cryptoBenchData.scenario];
+    uint32_t opsPerSec = 0U;
+
+    if (result->totalUs != 0U) {
+        opsPerSec = (result->iterations * 1000000U) / result->totalUs;
+    }
+
+    cDbgMsg(DBG_GEN_MSG, DBG_CRIT, "crypto_bench: %s: %d ops in %d us (max %d us), %d ops/s, "
+            "%d steps, %d failures, exp_mod peak %d B, heap peak %d B\n",
+            scenarios[cryptoBenchData.scenario].name, result->iterations, result->totalUs,
+            result->maxOperationUs, opsPerSec, result->steps, result->failures,
+            result->expModPeakMem, result->heapPeakMem);
+}
+
+/**
+ * Start scenario: start measurement of heap usage
+ */
+static void startScenarioHandler(void)
+{
+    reset_max_mem_allocated_static();
+    cryptoBenchData.iteration = 0U;
+    cryptoBenchData.stateCb = &startOperationHandler;
+}
+
+/**
+ * Finish scenario: save results, start next scenario
+ */
+static void finishScenario(void)
+{
+    CryptoBenchResult_t* result = &cryptoBenchData.results[cryptoBenchData.scenario];
+
+    result->heapPeakMem = get_max_mem_allocated_static();
+    printScenarioResult();
+
+    cryptoBenchData.scenario++;
+
+    if (cryptoBenchData.scenario < CRYPTO_BENCH_SCENARIOS) {
+        cryptoBenchData.stateCb = &startScenarioHandler;
+    } else {
+        /* Benchmark finished */
+        cryptoBenchData.stateCb = NULL;
+    }
+}
+
+/**
+ * Prepare operation and start its measurement
+ */
+static void startOperationHandler(void)
+{
+    const CryptoBenchScenario_t* scenario = &scenarios[cryptoBenchData.scenario];
+
+    LIB_HANDLER_Clean();
+
+    if (scenario->prepare() == CDN_EOK) {
+        startTimer(CRYPTO_BENCH_TIMER);
+        cryptoBenchData.stateCb = &operationHandler;
+    } else {
+        /* Rest of scenario is skipped */
+        cryptoBenchData.results[cryptoBenchData.scenario].failures++;
+        (void)scenario->finish(CDN_EINVAL);
+        finishScenario();
+    }
+}
+
+
+/**
+ * Do step of operation, start next operation or finish scenario after last one
+ */
+static void operationHandler(void)
+{
+    const CryptoBenchScenario_t* scenario = &scenarios[cryptoBenchData.scenario];
+    CryptoBenchResult_t* result = &cryptoBenchData.results[cryptoBenchData.scenario];
+    uint32_t operationUs;
+    uint32_t retVal;
+
+    retVal = scenario->step();
+    result->steps++;
+
+    if (retVal != CDN_EINPROGRESS) {
+        operationUs = getTimerUsWithoutUpdate(CRYPTO_BENCH_TIMER);
+        result->iterations++;
+        result->totalUs += operationUs;
+        if (operationUs > result->maxOperationUs) {
+            result->maxOperationUs = operationUs;
+        }
+
+        if (!scenario->finish(retVal)) {
+            result->failures++;
+        }
+
+        cryptoBenchData.iteration++;
+
+        if (cryptoBenchData.iteration < CRYPTO_BENCH_ITERATIONS) {
+            cryptoBenchData.stateCb = &startOperationHandler;
+        } else {
+            finishScenario();
+        }
+    }
+}
+
+/**
+ * Main thread of benchmark driver
+ */
+static void CRYPTO_BENCH_thread(void)
+{
+    if (cryptoBenchData.stateCb != NULL) {
+        (*cryptoBenchData.stateCb)();
+    } else {
+        modRunnerSuspendMe();
+    }
+}
+
+/**
+ * Function used to start benchmark driver
+ */
+static void CRYPTO_BENCH_start(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize benchmark driver
+ */
+static void CRYPTO_BENCH_init(void)
+{
+    uint32_t i;
+
+    (void)memset(cryptoBenchData.results, 0, sizeof(cryptoBenchData.results));
+
+    /* Message of bytes 0x00-0xFF */
+    for (i = 0U; i < CRYPTO_BENCH_MESSAGE_SIZE; i++) {
+        cryptoBenchData.message[i] = (uint8_t)i;
+    }
+
+    /* Set operands as empty */
+    ipi_free(&cryptoBenchData.A);
+    ipi_free(&cryptoBenchData.E);
+    ipi_free(&cryptoBenchData.N);
+    ipi_free(&cryptoBenchData.R);
+
+    /* R^2 mod N is calculated by first verification */
+    (void)ipi_mont_ctx_init(&cryptoBenchData.montCtx, cryptoBenchData.modulusLimbs, cryptoBenchData.rrLimbs,
+                            (uint16_t)CRYPTO_BENCH_RSA3072_LIMBS, modulus3072, CRYPTO_BENCH_RSA3072_SIZE);
+    (void)ipi_rd_binary_static(&cryptoBenchData.exponentIpi, &cryptoBenchData.exponentLimb, 1U,
+                               publicExp, CRYPTO_BENCH_PUBLIC_EXP_SIZE);
+
+    cryptoBenchData.scenario = 0U;
+    cryptoBenchData.stateCb = &startScenarioHandler;
+}
+
+const CryptoBenchResult_t* CRYPTO_BENCH_getResults(void)
+{
+    return cryptoBenchData.results;
+}
+
+bool CRYPTO_BENCH_isFinished(void)
+{
+    return cryptoBenchData.scenario >= CRYPTO_BENCH_SCENARIOS;
+}
+
+void CRYPTO_BENCH_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t cryptoBenchModule;
+
+    cryptoBenchModule.initTask = &CRYPTO_BENCH_init;
+    cryptoBenchModule.startTask = &CRYPTO_BENCH_start;
+    cryptoBenchModule.thread = &CRYPTO_BENCH_thread;
+    cryptoBenchModule.moduleId = MODRUNNER_MODULE_CRYPTO_BENCH;
+    cryptoBenchModule.pPriority = 0U;
+
+    modRunnerInsertModule(&cryptoBenchModule);
+}
+
+#endif // USE_CRYPTO_BENCH
@@ -0,0 +1,409 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * crypto_model.c
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_CRYPTO_BENCH
+#include "crypto_model.h"
+#include "utils.h"
+#include "reg.h"
+
+#include <string.h>
+
+/* Number of words in SHA-256 block */
+#define CRYPTO_MODEL_SHA_BLOCK_WORDS 16U
+/* Number of words in SHA-256 state (and hash) */
+#define CRYPTO_MODEL_SHA_STATE_WORDS 8U
+/* Number of SHA-256 rounds */
+#define CRYPTO_MODEL_SHA_ROUNDS 64U
+/* Number of words in AES block and AES-128 key */
+#define CRYPTO_MODEL_AES_BLOCK_WORDS 4U
+/* Number of bytes in AES block */
+#define CRYPTO_MODEL_AES_BLOCK_SIZE 16U
+/* Number of AES-128 rounds */
+#define CRYPTO_MODEL_AES_ROUNDS 10U
+/* Number of words in expanded AES-128 key */
+#define CRYPTO_MODEL_AES_ROUND_KEY_WORDS (CRYPTO_MODEL_AES_BLOCK_WORDS * (CRYPTO_MODEL_AES_ROUNDS + 1U))
+
+/* Address of register owned by model */
+#define CRYPTO_MODEL_REG(reg) (&mhdpRegBase->mhdp_apb_regs.reg##_p)
+
+typedef struct
+{
+    /* Intermediate hash of SHA-256 */
+    uint32_t shaState[CRYPTO_MODEL_SHA_STATE_WORDS];
+    /* Words of block written into SHA_256_DATA_IN */
+    uint32_t shaBlock[CRYPTO_MODEL_SHA_BLOCK_WORDS];
+    /* Number of words in block */
+    uint8_t shaBlockLen;
+    /* Expanded key, first words are bytes 0..15 of key in big-endian order */
+    uint32_t aesRoundKey[CRYPTO_MODEL_AES_ROUND_KEY_WORDS];
+    /* Key was changed and has to be expanded before next block */
+    bool aesKeyChanged;
+    /* Words of block written into AES_32_DATA_IN */
+    uint32_t aesBlock[CRYPTO_MODEL_AES_BLOCK_WORDS];
+    /* Number of words in block */
+    uint8_t aesBlockLen;
+    /* Encrypted block, first word is bytes 0..3 of block in big-endian order */
+    uint32_t aesOutput[CRYPTO_MODEL_AES_BLOCK_WORDS];
+    /* Value of CRYPTO22_STATUS */
+    uint32_t status;
+} CryptoModelData_t;
+
+static CryptoModelData_t cryptoModelData;
+
+/* SHA-256 initial hash (FIPS 180-4, 5.3.3) */
+static const uint32_t shaInitState[CRYPTO_MODEL_SHA_STATE_WORDS] = {
+    0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+    0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U
+};
+
+/* SHA-256 round constants (FIPS 180-4, 4.2.2) */
+static const uint32_t shaRoundConst[CRYPTO_MODEL_SHA_ROUNDS] = {
+    0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U, 0x3956C25BU, 0x59F111F1U, 0x923F82A4U, 0xAB1C5ED5U,
+    0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U, 0x72BE5D74U, 0x80DEB1FEU, 0x9BDC06A7U, 0xC19BF174U,
+    0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU, 0x2DE92C6FU, 0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU,
+    0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U, 0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U,
+    0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU, 0x53380D13U, 0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U,
+    0xA2BFE8A1U, 0xA81A664BU, 0xC24B8B70U, 0xC76C51A3U, 0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U,
+    0x19A4C116U, 0x1E376C08U, 0x2748774CU, 0x34B0BCB5U, 0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+    0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U, 0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U, 0xC67178F2U
+};
+
+/* AES S-box (FIPS 197, 5.1.1) */
+static const uint8_t aesSbox[256] = {
+    0x63U, 0x7CU, 0x77U, 0x7BU, 0xF2U, 0x6BU, 0x6FU, 0xC5U, 0x30U, 0x01U, 0x67U, 0x2BU, 0xFEU, 0xD7U, 0xABU, 0x76U,
+    0xCAU, 0x82U, 0xC9U, 0x7DU, 0xFAU, 0x59U, 0x47U, 0xF0U, 0xADU, 0xD4U, 0xA2U, 0xAFU, 0x9CU, 0xA4U, 0x72U, 0xC0U,
+    0xB7U, 0xFDU, 0x93U, 0x26U, 0x36U, 0x3FU, 0xF7U, 0xCCU, 0x34U, 0xA5U, 0xE5U, 0xF1U, 0x71U, 0xD8U, 0x31U, 0x15U,
+    0x04U, 0xC7U, 0x23U, 0xC3U, 0x18U, 0x96U, 0x05U, 0x9AU, 0x07U, 0x12U, 0x80U, 0xE2U, 0xEBU, 0x27U, 0xB2U, 0x75U,
+    0x09U, 0x83U, 0x2CU, 0x1AU, 0x1BU, 0x6EU, 0x5AU, 0xA0U, 0x52U, 0x3BU, 0xD6U, 0xB3U, 0x29U, 0xE3U, 0x2FU, 0x84U,
+    0x53U, 0xD1U, 0x00U, 0xEDU, 0x20U, 0xFCU, 0xB1U, 0x5BU, 0x6AU, 0xCBU, 0xBEU, 0x39U, 0x4AU, 0x4CU, 0x58U, 0xCFU,
+    0xD0U, 0xEFU, 0xAAU, 0xFBU, 0x43U, 0x4DU, 0x33U, 0x85U, 0x45U, 0xF9U, 0x02U, 0x7FU, 0x50U, 0x3CU, 0x9FU, 0xA8U,
+    0x51U, 0xA3U, 0x40U, 0x8FU, 0x92U, 0x9DU, 0x38U, 0xF5U, 0xBCU, 0xB6U, 0xDAU, 0x21U, 0x10U, 0xFFU, 0xF3U, 0xD2U,
+    0xCDU, 0x0CU, 0x13U, 0xECU, 0x5FU, 0x97U, 0x44U, 0x17U, 0xC4U, 0xA7U, 0x7EU, 0x3DU, 0x64U, 0x5DU, 0x19U, 0x73U,
+    0x60U, 0x81U, 0x4FU, 0xDCU, 0x22U, 0x2AU, 0x90U, 0x88U, 0x46U, 0xEEU, 0xB8U, 0x14U, 0xDEU, 0x5EU, 0x0BU, 0xDBU,
+    0xE0U, 0x32U, 0x3AU, 0x0AU, 0x49U, 0x06U, 0x24U, 0x5CU, 0xC2U, 0xD3U, 0xACU, 0x62U, 0x91U, 0x95U, 0xE4U, 0x79U,
+    0xE7U, 0xC8U, 0x37U, 0x6DU, 0x8DU, 0xD5U, 0x4EU, 0xA9U, 0x6CU, 0x56U, 0xF4U, 0xEAU, 0x65U, 0x7AU, 0xAEU, 0x08U,
+    0xBAU, 0x78U, 0x25U, 0x2EU, 0x1CU, 0xA6U, 0xB4U, 0xC6U, 0xE8U, 0xDDU, 0x74U, 0x1FU, 0x4BU, 0xBDU, 0x8BU, 0x8AU,
+    0x70U, 0x3EU, 0xB5U, 0x66U, 0x48U, 0x03U, 0xF6U, 0x0EU, 0x61U, 0x35U, 0x57U, 0xB9U, 0x86U, 0xC1U, 0x1DU, 0x9EU,
+    0xE1U, 0xF8U, 0x98U, 0x11U, 0x69U, 0xD9U, 0x8EU, 0x94U, 0x9BU, 0x1EU, 0x87U, 0xE9U, 0xCEU, 0x55U, 0x28U, 0xDFU,
+    0x8CU, 0xA1U, 0x89U, 0x0DU, 0xBFU, 0xE6U, 0x42U, 0x68U, 0x41U, 0x99U, 0x2DU, 0x0FU, 0xB0U, 0x54U, 0xBBU, 0x16U
+};
+
+/* AES key expansion round constants (FIPS 197, 5.2), first byte of word */
+static const uint8_t aesRcon[CRYPTO_MODEL_AES_ROUNDS] = {
+    0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U, 0x1BU, 0x36U
+};
+
+/**
+ * Rotate word right
+ * @param[in] val, rotated word
+ * @param[in] shift, number of bits, 1..31
+ * @return rotated word
+ */
+static inline uint32_t rotr32(uint32_t val, uint8_t shift)
+{
+    return safe_shift32(RIGHT, val, shift) | safe_shift32(LEFT, val, 32U - shift);
+}
+
+/**
+ * Start new SHA-256 message
+ */
+static void shaStart(void)
+{
+    uint8_t i;
+
+    for (i = 0U; i < CRYPTO_MODEL_SHA_STATE_WORDS; i++) {
+        cryptoModelData.shaState[i] = shaInitState[i];
+    }
+
+    cryptoModelData.shaBlockLen = 0U;
+}
+
+/**
+ * Process collected SHA-256 block (FIPS 180-4, 6.2.2)
+ */
+static void shaProcessBlock(void)
+{
+    uint32_t w[CRYPTO_MODEL_SHA_ROUNDS];
+    uint32_t v[CRYPTO_MODEL_SHA_STATE_WORDS];
+    uint32_t s0;
+    uint32_t s1;
+    uint32_t t1;
+    uint32_t t2;
+    uint8_t i;
+
+    for (i = 0U; i < CRYPTO_MODEL_SHA_ROUNDS; i++) {
+        if (i < CRYPTO_MODEL_SHA_BLOCK_WORDS) {
+            w[i] = cryptoModelData.shaBlock[i];
+        } else {
+            s0 = rotr32(w[i - 15U], 7U) ^ rotr32(w[i - 15U], 18U) ^ (w[i - 15U] >> 3U);
+            s1 = rotr32(w[i - 2U], 17U) ^ rotr32(w[i - 2U], 19U) ^ (w[i - 2U] >> 10U);
+            w[i] = w[i - 16U] + s0 + w[i - 7U] + s1;
+        }
+    }
+
+    for (i = 0U; i < CRYPTO_MODEL_SHA_STATE_WORDS; i++) {
+        v[i] = cryptoModelData.shaState[i];
+    }
+
+    /* v[0..7] are working variables a..h */
+    for (i = 0U; i < CRYPTO_MODEL_SHA_ROUNDS; i++) {
+        s1 = rotr32(v[4], 6U) ^ rotr32(v[4], 11U) ^ rotr32(v[4], 25U);
+        t1 = v[7] + s1 + ((v[4] & v[5]) ^ (~v[4] & v[6])) + shaRoundConst[i] + w[i];
+        s0 = rotr32(v[0], 2U) ^ rotr32(v[0], 13U) ^ rotr32(v[0], 22U);
+        t2 = s0 + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+
+        v[7] = v[6];
+        v[6] = v[5];
+        v[5] = v[4];
+        v[4] = v[3] + t1;
+        v[3] = v[2];
+        v[2] = v[1];
+        v[1] = v[0];
+        v[0] = t1 + t2;
+    }
+
+    for (i = 0U; i < CRYPTO_MODEL_SHA_STATE_WORDS; i++) {
+        cryptoModelData.shaState[i] += v[i];
+    }
+}
+
+/**
+ * Collect word of SHA-256 block, block is processed after last word
+ * @param[in] value, word written into SHA_256_DATA_IN
+ */
+static void shaWriteData(uint32_t value)
+{
+    /* Status is cleared by first word of next block */
+    cryptoModelData.status &= ~RegFieldSet(CRYPTO22_STATUS, SHA256_NEXT_MESSAGE_ST, 0U);
+
+    cryptoModelData.shaBlock[cryptoModelData.shaBlockLen] = value;
+    cryptoModelData.shaBlockLen++;
+
+    if (cryptoModelData.shaBlockLen == CRYPTO_MODEL_SHA_BLOCK_WORDS) {
+        shaProcessBlock();
+        cryptoModelData.shaBlockLen = 0U;
+        cryptoModelData.status |= RegFieldSet(CRYPTO22_STATUS, SHA256_NEXT_MESSAGE_ST, 0U);
+    }
+}
+
+/**
+ * Apply S-box to each byte of word
+ * @param[in] word, input word
+ * @return substituted word
+ */
+static uint32_t aesSubWord(uint32_t word)
+{
+    uint8_t bytes[NUMBER_OF_BYTES_IN_UINT32T];
+    uint8_t i;
+
+    setBe32(word, bytes);
+    for (i = 0U; i < NUMBER_OF_BYTES_IN_UINT32T; i++) {
+        bytes[i] = aesSbox[bytes[i]];
+    }
+
+    return getBe32(bytes);
+}
+
+/**
+ * Expand AES-128 key (FIPS 197, 5.2), key is in first words of round key
+ */
+static void aesExpandKey(void)
+{
+    uint32_t* w = cryptoModelData.aesRoundKey;
+    uint32_t temp;
+    uint8_t i;
+
+    for (i = CRYPTO_MODEL_AES_BLOCK_WORDS; i < CRYPTO_MODEL_AES_ROUND_KEY_WORDS; i++) {
+        temp = w[i - 1U];
+        if ((i % CRYPTO_MODEL_AES_BLOCK_WORDS) == 0U) {
+            temp = aesSubWord((temp << 8U) | (temp >> 24U))
+                 ^ ((uint32_t)aesRcon[(i / CRYPTO_MODEL_AES_BLOCK_WORDS) - 1U] << 24U);
+        }
+        w[i] = w[i - CRYPTO_MODEL_AES_BLOCK_WORDS] ^ temp;
+    }
+
+    cryptoModelData.aesKeyChanged = false;
+}
+
+/**
+ * Multiply byte by x in GF(2^8)
+ * @param[in] val, multiplied byte
+ * @return product
+ */
+static inline uint8_t aesXtime(uint8_t val)
+{
+    uint8_t product = (uint8_t)(val << 1U);
+
+    if ((val & 0x80U) != 0U) {
+        product ^= 0x1BU;
+    }
+
+    return product;
+}
+
+/**
+ * XOR state with round key
+ * @param[inout] state, AES state, byte index is column * 4 + row
+ * @param[in] round, index of round key
+ */
+static void aesAddRoundKey(uint8_t state[CRYPTO_MODEL_AES_BLOCK_SIZE], uint8_t round)
+{
+    uint8_t key[NUMBER_OF_BYTES_IN_UINT32T];
+    uint8_t col;
+    uint8_t row;
+
+    for (col = 0U; col < CRYPTO_MODEL_AES_BLOCK_WORDS; col++) {
+        setBe32(cryptoModelData.aesRoundKey[(round * CRYPTO_MODEL_AES_BLOCK_WORDS) + col], key);
+        for (row = 0U; row < NUMBER_OF_BYTES_IN_UINT32T; row++) {
+            state[(col * 4U) + row] ^= key[row];
+        }
+    }
+}
+
+/**
+ * Mix each column of state (FIPS 197, 5.1.3)
+ * @param[inout] state, AES state, byte index is column * 4 + row
+ */
+static void aesMixColumns(uint8_t state[CRYPTO_MODEL_AES_BLOCK_SIZE])
+{
+    uint8_t* a;
+    uint8_t all;
+    uint8_t first;
+    uint8_t col;
+
+    for (col = 0U; col < CRYPTO_MODEL_AES_BLOCK_WORDS; col++) {
+        a = &state[col * 4U];
+        all = a[0] ^ a[1] ^ a[2] ^ a[3];
+        first = a[0];
+
+        a[0] ^= all ^ aesXtime(a[0] ^ a[1]);
+        a[1] ^= all ^ aesXtime(a[1] ^ a[2]);
+        a[2] ^= all ^ aesXtime(a[2] ^ a[3]);
+        a[3] ^= all ^ aesXtime(a[3] ^ first);
+    }
+}
+
+/**
+ * Encrypt collected AES-128 block (FIPS 197, 5.1)
+ */
+static void aesEncryptBlock(void)
+{
+    uint8_t state[CRYPTO_MODEL_AES_BLOCK_SIZE];
+    uint8_t shifted[CRYPTO_MODEL_AES_BLOCK_SIZE];
+    uint8_t round;
+    uint8_t col;
+    uint8_t row;
+
+    if (cryptoModelData.aesKeyChanged) {
+        aesExpandKey();
+    }
+
+    for (col = 0U; col < CRYPTO_MODEL_AES_BLOCK_WORDS; col++) {
+        setBe32(cryptoModelData.aesBlock[col], &state[col * 4U]);
+    }
+
+    aesAddRoundKey(state, 0U);
+
+    for (round = 1U; round <= CRYPTO_MODEL_AES_ROUNDS; round++) {
+        /* SubBytes and ShiftRows, row r is rotated left by r columns */
+        for (col = 0U; col < CRYPTO_MODEL_AES_BLOCK_WORDS; col++) {
+            for (row = 0U; row < NUMBER_OF_BYTES_IN_UINT32T; row++) {
+                shifted[(col * 4U) + row] = aesSbox[state[(((col + row) % 4U) * 4U) + row]];
+            }
+        }
+
+        if (round < CRYPTO_MODEL_AES_ROUNDS) {
+            aesMixColumns(shifted);
+        }
+
+        (void)memcpy(state, shifted, CRYPTO_MODEL_AES_BLOCK_SIZE);
+        aesAddRoundKey(state, round);
+    }
+
+    for (col = 0U; col < CRYPTO_MODEL_AES_BLOCK_WORDS; col++) {
+        cryptoModelData.aesOutput[col] = getBe32(&state[col * 4U]);
+    }
+}
+
+/**
+ * Collect word of AES block, block is encrypted after last word
+ * @param[in] value, word written into AES_32_DATA_IN
+ */
+static void aesWriteData(uint32_t value)
+{
+    /* Status is cleared by first word of next block */
+    cryptoModelData.status &= ~RegFieldSet(CRYPTO22_STATUS, AES_32_DONE_ST, 0U);
+
+    cryptoModelData.aesBlock[cryptoModelData.aesBlockLen] = value;
+    cryptoModelData.aesBlockLen++;
+
+    if (cryptoModelData.aesBlockLen == CRYPTO_MODEL_AES_BLOCK_WORDS) {
+        aesEncryptBlock();
+        cryptoModelData.aesBlockLen = 0U;
+        cryptoModelData.status |= RegFieldSet(CRYPTO22_STATUS, AES_32_DONE_ST, 0U);
+    }
+}
+
+/**
+ * Set word of AES key, AES_32_KEY_0 holds last bytes of key
+ * @param[in] idx, index of key register
+ * @param[in] value, word written into key register
+ */
+static void aesWriteKey(uint8_t idx, uint32_t value)
+{
+    cryptoModelData.aesRoundKey[(CRYPTO_MODEL_AES_BLOCK_WORDS - 1U) - idx] = value;
+    cryptoModelData.aesKeyChanged = true;
+}
+
+bool CRYPTO_MODEL_regRead(const volatile uint32_t* address, uint32_t* value)
+{
+    bool served = true;
+
+    if (address == CRYPTO_MODEL_REG(CRYPTO22_STATUS)) {
+        *value = cryptoModelData.status;
+    } else if ((address >= CRYPTO_MODEL_REG(SHA_256_DATA_OUT_0)) && (address <= CRYPTO_MODEL_REG(SHA_256_DATA_OUT_7))) {
+        *value = cryptoModelData.shaState[address - CRYPTO_MODEL_REG(SHA_256_DATA_OUT_0)];
+    } else if ((address >= CRYPTO_MODEL_REG(AES_32_DATA_OUT_0)) && (address <= CRYPTO_MODEL_REG(AES_32_DATA_OUT_3))) {
+        /* AES_32_DATA_OUT_3 holds first bytes of block */
+        *value = cryptoModelData.aesOutput[CRYPTO_MODEL_REG(AES_32_DATA_OUT_3) - address];
+    } else {
+        served = false;
+    }
+
+    return served;
+}
+
+bool CRYPTO_MODEL_regWrite(const volatile uint32_t* address, uint32_t value)
+{
+    bool served = true;
+
+    if (address == CRYPTO_MODEL_REG(CRYPTO22_CONFIG)) {
+        if (RegFieldRead(CRYPTO22_CONFIG, SHA_256_START, value) != 0U) {
+            shaStart();
+        }
+    } else if (address == CRYPTO_MODEL_REG(SHA_256_DATA_IN)) {
+        shaWriteData(value);
+    } else if ((address >= CRYPTO_MODEL_REG(AES_32_KEY_0)) && (address <= CRYPTO_MODEL_REG(AES_32_KEY_3))) {
+        aesWriteKey((uint8_t)(address - CRYPTO_MODEL_REG(AES_32_KEY_0)), value);
+    } else if (address == CRYPTO_MODEL_REG(AES_32_DATA_IN)) {
+        aesWriteData(value);
+    } else {
+        served = false;
+    }
+
+    return served;
+}
+
+#endif // USE_CRYPTO_BENCH
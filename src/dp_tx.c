@@ -18,11 +18,14 @@
 
 #include "dp_tx.h"
 #include "dp_tx_mail_handler.h"
+#include "dp_tx_snapshot.h"
 #include "timer.h"
 #include "utils.h"
 #include "reg.h"
 #include "cdn_stdtypes.h"
 
+#include <string.h>
+
 /**
  * Configuration of DP_TX module
  */
@@ -30,10 +33,20 @@
 #define DP_MAX_DEFER_TRIES 7U
 /* Time in microseconds for which module is slept after DP_REPLY_DEFER reply */
 #define DP_DEFER_TIMEOUT_US 400U
+/* Maximum number of DP_REQUEST_WRITE_UPDATE requests sent for single I2C write transaction */
+#define DP_MAX_WRITE_UPDATE_TRIES 32U
+/* Time in microseconds for which module is slept before DP_REQUEST_WRITE_UPDATE request */
+#define DP_WRITE_UPDATE_TIMEOUT_US 400U
 /* Number transaction restarts if timeout was reached*/
 #define DP_MAX_REPLY_TRIES 5U
-/* Time in microsecond for which transaction can occupy physical lane */
+/* Time in microsecond for which transaction can occupy physical lane.
+   Used as reply timeout by AUX controller (AUX_MAIN_EXPIRE_TX interrupt) */
 #define DP_AUX_TRANSACTION_TIMEOUT_US 500U
+/* Frequency of AUX controller timer in MHz (2 MHz clock set by DP_AUX_DIVIDE_2M) */
+#define DP_AUX_TIMER_CLOCK_MHZ 2U
+/* Time in microseconds after which waiting for TX_DONE or reply interrupt
+   is given up. Safety net only, reply timeout is detected by controller */
+#define DP_AUX_WATCHDOG_TIMEOUT_US 2000U
 /* Mask of AUX frame start bit */
 #define DP_TX_FRAME_START 0x100U
 /* Mask of AUX frame end bit */
@@ -97,6 +110,10 @@ typedef struct
     uint8_t timeoutCounter;
     /* Number of defer responses (give up transaction after 7 defer - DP doc) */
     uint8_t deferCounter;
+    /* Number of DP_REQUEST_WRITE_UPDATE requests sent for current I2C write transaction */
+    uint8_t updateCounter;
+    /* Command of last sent transaction, repeated after AUX DEFER reply */
+    uint8_t sentCommand;
     /* Number of bytes to read/write in current transaction */
     uint8_t transaction_bytes;
     /* Number of remaining bytes for request from policy */
@@ -107,38 +124,47 @@ typedef struct
     bool motState;
     /* I2C repeated start to be performed during read flag */
     bool repeatedStart;
+    /* Reply reported to policy after MOT=0 request, NACK of stopped transaction or DP_REPLY_ACK */
+    uint8_t stopReply;
     /* Callback function given by policy */
     ResponseCallback_t policyCallback;
     /* Data transmission finished flag*/
     uint8_t txDoneIrqFlag;
     /* Data receive finished flag */
     uint8_t rxDoneIrqFlag;
+    /* Reply timer expired flag */
+    uint8_t timeoutIrqFlag;
     /* Unplug event flag */
     uint8_t unpluggedIrqFlag;
     /* Plug event flag */
     uint8_t pluggedIrqFlag;
     /* Plug-in flag */
     bool plugged;
+    /* Statistics of channel (AUX or I2C) used by current request */
+    DpTxChannelStats_t* stats;
+    /* Deadline of current transaction phase is scheduled in modRunner */
+    bool deadlineArmed;
 } DpTxData_t;
 
 static DpTxData_t dpTxData;
 
+static DpTxStats_t dpTxStats;
+
 /******************************************
  * Handlers to DPTX module states actions.
  ******************************************/
 
 /**
  * Thread action corresponding to TX transaction.
- * Checks if data were send to RX (TX_DONE interrupt occured)
- * or if timeout for transaction was reached.
+ * Called when module was woken up by TX_DONE interrupt or when deadline
+ * of transaction was reached. In other case module is put to sleep.
  */
 static void sendingHandler(void);
 
 /**
  * Thread action corresponding to RX transaction.
- * Checks if data were send to TX (RX_DONE interrupt occured)
- * or if timeout was reached (if transmission was not started in DP_AUX_REPLY_TIMEOUT
- * or transmission was started but not finished in DP_AUX_TRANSACTION_TIMEOUT)
+ * Called when module was woken up by RX_DONE or reply timer (AUX_MAIN_EXPIRE_TX)
+ * interrupt. Reply is processed and policy callback is called in the same dispatch.
  */
 static void waitForResponseHandler(void);
 
@@ -148,7 +174,13 @@ static void waitForResponseHandler(void);
 static void resendHandler(void);
 
 /**
- * Thread action responsible for timeout service. Renew request or finish
+ * Thread action sending next transaction of request (DP_REQUEST_WRITE_UPDATE
+ * or address-only MOT=0 request), without counting it as retry
+ */
+static void sendNextHandler(void);
+
+/**
+ * Function responsible for timeout service. Renew request or finish
  * if renewed DP_MAX_REPLY_TRIES before
  */
 static void timeoutHandler(void);
@@ -167,6 +199,68 @@ static inline void checkSynchronization(void)
     }
 }
 
+/**
+ * Return statistics of channel used by request
+ * @param[in] command, command of request
+ * @return pointer to statistics of AUX or I2C-over-AUX channel
+ */
+static inline DpTxChannelStats_t* getChannelStats(uint8_t command)
+{
+    DpTxChannelStats_t* stats;
+
+    if ((command & (uint8_t)DP_REQUEST_TYPE_MASK) == (uint8_t)DP_REQUEST_TYPE_AUX) {
+        stats = &dpTxStats.aux;
+    } else {
+        stats = &dpTxStats.i2c;
+    }
+
+    return stats;
+}
+
+/**
+ * Add latency into log2 histogram
+ * @param[out] histogram, array of DP_TX_STATS_HIST_BUCKETS buckets
+ * @param[in] latencyUs, measured latency in microseconds
+ */
+static void updateHistogram(uint32_t* histogram, uint32_t latencyUs)
+{
+    uint32_t value = latencyUs;
+    uint8_t bucket = 0U;
+
+    /* Find position of most significant bit, saturate on last bucket */
+    while ((value > 1U) && (bucket < ((uint8_t)DP_TX_STATS_HIST_BUCKETS - 1U))) {
+        value = value >> 1U;
+        bucket++;
+    }
+
+    histogram[bucket]++;
+}
+
+/**
+ * Count reply of sink in statistics of current channel
+ * @param[in] replyCode, code of reply (ACK, NACK, DEFER or invalid)
+ */
+static void updateReplyStats(uint8_t replyCode)
+{
+    DpTxChannelStats_t* stats = dpTxData.stats;
+
+    switch (replyCode)
+    {
+    case (uint8_t)DP_REPLY_ACK:
+        stats->ackCount++;
+        break;
+    case (uint8_t)DP_REPLY_NACK:
+        stats->nackCount++;
+        break;
+    case (uint8_t)DP_REPLY_DEFER:
+        stats->deferCount++;
+        break;
+    default:
+        stats->invalidCount++;
+        break;
+    }
+}
+
 /**
  * Used to check if next transaction is address-only. Called during
  * transaction header folding
@@ -262,6 +356,15 @@ static inline void sendRequestData(void)
     RegWrite(DP_AUX_TX_DATA, ((uint32_t)DP_TX_FRAME_END | (uint32_t)dpTxData.requestData->buffer[i]));
 }
 
+/**
+ * Clear reply timer of AUX controller
+ */
+static inline void clearReplyTimer(void)
+{
+    uint32_t regVal = RegFieldSet(DP_AUX_TIMER_CLEAR, AUX_HOST_CLEAR_TIMER, 0U);
+    RegWrite(DP_AUX_TIMER_CLEAR, regVal);
+}
+
 /**
  * Send transaction header and data, if transaction type is DP_REQUEST_WRITE
  */
@@ -274,15 +377,27 @@ static void sendRequest(void)
         dpTxData.transaction_bytes = (uint8_t)dpTxData.dataCounter;
     }
 
+    /* Restart reply timer of controller */
+    clearReplyTimer();
+    dpTxData.timeoutIrqFlag = 0U;
+
     sendRequestHeader();
 
-    if ((dpTxData.requestData->command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_WRITE) {
+    /* DP_REQUEST_WRITE_UPDATE and MOT=0 requests are address-only, even if request is DP_REQUEST_WRITE */
+    if (((dpTxData.transactionData.command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_WRITE)
+        && (dpTxData.transaction_bytes > 0U)) {
         /* If request type is DP_REQUEST_WRITE - send data */
         sendRequestData();
     }
 
-    /* Start time measure and go to DP_TX_SENDING state */
+    dpTxData.sentCommand = dpTxData.transactionData.command;
+
+    dpTxData.stats->transactions++;
+
+    /* Start time measure and go to DP_TX_SENDING state, deadline
+       is scheduled when module is waiting for interrupt */
     startTimer(DP_AUX_TRANSACTION_TIMER);
+    dpTxData.deadlineArmed = false;
     dpTxData.stateCb = &sendingHandler;
 }
 
@@ -314,6 +429,7 @@ static void startNextTransaction(DpRequestType_t reqType)
     /* Clear counters */
     dpTxData.timeoutCounter = 0U;
     dpTxData.deferCounter = 0U;
+    dpTxData.updateCounter = 0U;
 
     /* Prepare same command as previous transaction */
     dpTxData.transactionData.command = dpTxData.requestData->command;
@@ -350,32 +466,6 @@ static inline void resetAux(void) {
     resetRx();
 }
 
-/**
- * Send DP_REQUEST_WRITE_UPDATE command. Function should be called when replier return information,
- * that number of written data is lower than required
- */
-static void updateStatusI2C(void)
-{
-    uint8_t bytesDiff = dpTxData.transactionData.buffer[0] - dpTxData.transactionDataCounter;
-    resetAux();
-
-    /* Bytes replied is disparity of expected and received data */
-    dpTxData.requestData->bytes_reply += (uint32_t)bytesDiff;
-    dpTxData.transactionDataCounter = dpTxData.transactionData.buffer[0];
-
-    /* Prepare DP_REQUEST_WRITE_UPDATE command */
-    dpTxData.transactionData.command = (uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)DP_REQUEST_WRITE_UPDATE;
-
-    /* Clear counters */
-    dpTxData.timeoutCounter = 0U;
-    dpTxData.deferCounter = 0U;
-
-    /* Go to state corresponding with RX response*/
-    dpTxData.stateCb = &waitForResponseHandler;
-
-    /* [DP_TX]>>>WRITE I2C ACK [%d bytes written, try again with CMD [0x%x]] */
-}
-
 /**
  * Handler to DP_TX callback. Should be called always when request (or sequence of requests)
  * was finished.
@@ -384,8 +474,14 @@ static void updateStatusI2C(void)
 static void finishRequest(void)
 {
     if (dpTxData.policyCallback != NULL) {
+        dpTxData.stats->bytes += dpTxData.requestData->bytes_reply;
+
         /* If callback is not NULL, call itto finish request */
         dpTxData.requestData->command = dpTxData.transactionData.command;
+        if (dpTxData.stopReply != (uint8_t)DP_REPLY_ACK) {
+            /* Reply to MOT=0 request does not hide NACK of stopped transaction */
+            dpTxData.requestData->command = dpTxData.stopReply;
+        }
         dpTxData.policyCallback(dpTxData.requestData);
         dpTxData.policyCallback = NULL;
     }
@@ -393,6 +489,9 @@ static void finishRequest(void)
     /* Cleanup interrupt flags to be sure that no previous interrupts will be used */
     dpTxData.rxDoneIrqFlag = 0U;
     dpTxData.txDoneIrqFlag = 0U;
+    dpTxData.timeoutIrqFlag = 0U;
+    dpTxData.deadlineArmed = false;
+    dpTxData.stopReply = (uint8_t)DP_REPLY_ACK;
 
     /* Clear transaction registers */
     resetAux();
@@ -402,6 +501,60 @@ static void finishRequest(void)
 }
 /* parasoft-end-suppress METRICS-36 */
 
+/**
+ * Stop I2C transaction by address-only request with MOT=0,
+ * request is finished after reply
+ */
+static void stopTransactionI2C(void)
+{
+    dpTxData.dataCounter = 0U;
+    dpTxData.transactionDataCounter = 0U;
+    /* No data in MOT=0 request, it is address-only */
+    dpTxData.transaction_bytes = 0U;
+    dpTxData.motState = false;
+    dpTxData.transactionData.command = dpTxData.requestData->command;
+    dpTxData.stateCb = &sendNextHandler;
+}
+
+/**
+ * Poll sink with DP_REQUEST_WRITE_UPDATE command, until all bytes of I2C write
+ * transaction are written. Polling has own limit, because I2C slave may need
+ * more time than allowed by DP_MAX_DEFER_TRIES.
+ */
+static void requestWriteUpdateI2C(void)
+{
+    resetAux();
+
+    if (dpTxData.updateCounter < DP_MAX_WRITE_UPDATE_TRIES) {
+        /* [DP_TX]>>>WRITE I2C [%d bytes written, write status update CMD [0x%x]] */
+        modRunnerSleep(DP_WRITE_UPDATE_TIMEOUT_US);
+        dpTxData.updateCounter++;
+        dpTxData.transactionData.command = (uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)DP_REQUEST_WRITE_UPDATE;
+        dpTxData.stateCb = &sendNextHandler;
+    } else if (dpTxData.motState) {
+        /* [DP_TX]>>>WRITE I2C [give up, send MOT=0 CMD [0x%x]] */
+        stopTransactionI2C();
+    } else {
+        finishRequest();
+    }
+}
+
+/**
+ * Count bytes written by sink, reported in M byte of reply. M is number of bytes
+ * of current transaction written so far, also in replies to DP_REQUEST_WRITE_UPDATE
+ */
+static void updateStatusI2C(void)
+{
+    uint8_t written = dpTxData.transactionData.buffer[0];
+
+    /* Sink must not report less bytes than before or more than sent */
+    if ((written >= dpTxData.transactionDataCounter) && (written <= dpTxData.transaction_bytes)) {
+        /* Bytes replied is disparity of expected and received data */
+        dpTxData.requestData->bytes_reply += (uint32_t)written - (uint32_t)dpTxData.transactionDataCounter;
+        dpTxData.transactionDataCounter = written;
+    }
+}
+
 /**
  * Check if response word have DP_TX_FRAME_END indicator
  * @param[in] responseData, analyzed response word
@@ -562,7 +715,8 @@ static void processResponseDeferAux(void)
            "[DP_TX]>>>AUX DEFER [try again CMD [0x%x]]" */
         modRunnerSleep(DP_DEFER_TIMEOUT_US);
         dpTxData.deferCounter++;
-        dpTxData.transactionData.command = dpTxData.requestData->command;
+        /* Repeat last transaction, it may differ from request (DP_REQUEST_WRITE_UPDATE) */
+        dpTxData.transactionData.command = dpTxData.sentCommand;
         dpTxData.stateCb = &resendHandler;
     } else {
         /* After DP_MAX_DEFER_TRIES defer replies, give up
@@ -599,17 +753,25 @@ static void processResponseAckI2C(void)
         dpTxData.transaction_bytes = dpTxData.transactionData.length;
         break;
     case ((uint8_t)DP_REQUEST_WRITE):
-        /* ACK response for write request */
+        /* ACK response for write request or for DP_REQUEST_WRITE_UPDATE sent during write */
         if (dpTxData.transactionData.length > 0U) {
-            /* If reply contain something more than ACK, it means that not all data was written,
-               need to send DP_REQUEST_WRITE_UPDATE command and wait */
             updateStatusI2C();
-            statusUpdating = true;
+        }
 
-        } else {
-            /* All bytes was written - [DP_TX]>>>WRITE I2C ACK [%d bytes written] */
-            byteDiff = dpTxData.transaction_bytes - dpTxData.transactionDataCounter;
-            dpTxData.requestData->bytes_reply += (uint32_t)byteDiff;
+        if (dpTxData.transactionDataCounter < dpTxData.transaction_bytes) {
+            if (dpTxData.transactionData.length > 0U) {
+                /* If reply contain something more than ACK, it means that not all data was written,
+                   need to send DP_REQUEST_WRITE_UPDATE command and wait */
+                requestWriteUpdateI2C();
+                statusUpdating = true;
+            } else {
+                /* All bytes was written - [DP_TX]>>>WRITE I2C ACK [%d bytes written] */
+                byteDiff = dpTxData.transaction_bytes - dpTxData.transactionDataCounter;
+                dpTxData.requestData->bytes_reply += (uint32_t)byteDiff;
+            }
+        }
+
+        if (!statusUpdating) {
             dpTxData.transactionDataCounter = 0U;
         }
         break;
@@ -635,9 +797,7 @@ static void processResponseAckI2C(void)
             } else if (dpTxData.motState && dpTxData.requestData->endTransaction) {
                 /* Send address only MOT = 0 request to stop I2C transaction
                    [DP_TX]>>>I2C ACK [all data processed, send MOT=0 address only request] */
-                dpTxData.motState = false;
-                dpTxData.transactionData.command = dpTxData.requestData->command;
-                dpTxData.stateCb = &waitForResponseHandler;
+                stopTransactionI2C();
 
             } else {
                 /* [DP_TX]>>>I2C ACK [all data processed, back to callback] */
@@ -651,20 +811,17 @@ static void processResponseNackI2C(void)
 {
     /* [DP_TX]>>>I2C NACK [finish transaction with MOT=0, CMD [0x%x]] */
 
-    uint8_t byteDiff;
-
     /* Callback function with error state, handle M byte */
-    if (dpTxData.transactionData.length > 0U) {
-        //M byte present indicationg number of written bytes
-        byteDiff = dpTxData.transactionData.buffer[0] - dpTxData.transactionDataCounter;
-        dpTxData.requestData->bytes_reply += (uint32_t)byteDiff;
-        dpTxData.transactionDataCounter = 0U;
-        dpTxData.dataCounter = 0U;
-        dpTxData.motState = false;
-        dpTxData.transactionData.command = dpTxData.requestData->command;
-        dpTxData.stateCb = &waitForResponseHandler;
+    if ((dpTxData.transactionData.length > 0U) && dpTxData.motState) {
+        //M byte present indicationg number of written bytes, report NACK after MOT=0 reply
+        updateStatusI2C();
+        dpTxData.stopReply = dpTxData.transactionData.command;
+        stopTransactionI2C();
 
     } else {
+        if (dpTxData.transactionData.length > 0U) {
+            updateStatusI2C();
+        }
         dpTxData.requestData->command = dpTxData.transactionData.command;
         finishRequest();
     }
@@ -677,34 +834,26 @@ static void processResponseNackI2C(void)
 
 static void processResponseDeferI2C(void)
 {
-    /* Sink is not ready, try again up to DP_MAX_DEFER_TRIES times */
-    if (dpTxData.deferCounter < DP_MAX_DEFER_TRIES) {
-        /* After defer try again up to DP_MAX_DEFER_TRIES times in a row
+    if ((dpTxData.requestData->command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_WRITE) {
+        /* In case of write poll sink with write update, up to DP_MAX_WRITE_UPDATE_TRIES times
+           [DP_TX]>>>I2C DEFER [try again write update CMD [0x%x]] */
+        requestWriteUpdateI2C();
+
+    } else if (dpTxData.deferCounter < DP_MAX_DEFER_TRIES) {
+        /* Sink is not ready, try again up to DP_MAX_DEFER_TRIES times in a row
            Make some delay before another try */
         modRunnerSleep(DP_DEFER_TIMEOUT_US);
         dpTxData.deferCounter++;
-        if ((dpTxData.requestData->command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_WRITE) {
-            /* In case of write send write update
-               [DP_TX]>>>I2C DEFER [try again write update CMD [0x%x]] */
-            dpTxData.transactionData.command = (uint8_t)DP_REQUEST_TYPE_I2C
-                                              | (uint8_t)DP_REQUEST_WRITE_UPDATE;
-        } else {
-            /* In case of read repeat the same request
-               [DP_TX]>>>I2C DEFER [try again read CMD [0x%x]] */
-            dpTxData.transactionData.command = dpTxData.requestData->command;
-        }
-
+        /* In case of read repeat the same request
+           [DP_TX]>>>I2C DEFER [try again read CMD [0x%x]] */
+        dpTxData.transactionData.command = dpTxData.requestData->command;
         dpTxData.stateCb = &resendHandler;
 
     } else {
         if (dpTxData.motState) {
             /* After DP_MAX_DEFER_TRIES defer replies, give up and send MOT = 0 to stop I2C transaction
                [DP_TX]>>>I2C DEFER [give up, send MOT=0 CMD [0x%x]] */
-            dpTxData.dataCounter = 0U;
-            dpTxData.transactionDataCounter = 0U;
-            dpTxData.motState = false;
-            dpTxData.transactionData.command = dpTxData.requestData->command;
-            dpTxData.stateCb = &resendHandler;
+            stopTransactionI2C();
         } else {
             finishRequest();
         }
@@ -776,15 +925,19 @@ static void processHandler(void)
 
     if ((dpTxData.requestData->command & (uint8_t)DP_REQUEST_TYPE_MASK) == (uint8_t)DP_REQUEST_TYPE_AUX) {
         /* Response to AUX request */
+        updateReplyStats(auxResponse);
         responseHandler(auxResponse, &auxHandlers);
     } else {
         /* Response to I2C request. Check if AUX part is ACK */
         if (auxResponse == (uint8_t)DP_REPLY_ACK) {
+            updateReplyStats(i2cResponse);
             responseHandler(i2cResponse, &i2cHandlers);
         } else if (auxResponse == (uint8_t)DP_REPLY_DEFER) {
+            updateReplyStats(auxResponse);
             processResponseDeferAux();
         } else {
             /* Handle incorrect response, clear flags, go to callback */
+            updateReplyStats(auxResponse);
             incorrectResponseHandler();
         }
     }
@@ -797,34 +950,62 @@ static void processHandler(void)
  ********************************************
  */
 
-static void waitForResponseHandler(void) {
+/**
+ * Put module to sleep until AUX interrupt. Watchdog deadline, used only
+ * if interrupt was lost, is scheduled once per transaction phase.
+ */
+static void waitForEvent(void)
+{
+    if (!dpTxData.deadlineArmed) {
+        modRunnerSetTimeout(DP_AUX_WATCHDOG_TIMEOUT_US);
+        dpTxData.deadlineArmed = true;
+    }
 
-    uint32_t timerVal;
+    modRunnerSleep(DP_AUX_WATCHDOG_TIMEOUT_US);
 
-    static bool auxRxInProcess = false;
+    /* Interrupt could occur after flags were checked, do not miss it */
+    if ((dpTxData.txDoneIrqFlag == 1U) || (dpTxData.rxDoneIrqFlag == 1U) || (dpTxData.timeoutIrqFlag == 1U)) {
+        modRunnerWakeMe();
+    }
+}
+
+/**
+ * Check if watchdog deadline of current transaction phase was reached
+ * @return 'true' if deadline was reached or 'false' if not
+ */
+static inline bool isDeadlineReached(void)
+{
+    return dpTxData.deadlineArmed && modRunnerIsTimeoutExpired();
+}
+
+static void waitForResponseHandler(void) {
 
     /* If interrupt occured, data are ready to read */
     if (dpTxData.rxDoneIrqFlag == 1U) {
         dpTxData.rxDoneIrqFlag = 0U;
-        auxRxInProcess = false;
+        dpTxData.deadlineArmed = false;
+
+        updateHistogram(dpTxData.stats->rxDoneHist, getTimerUsWithoutUpdate(DP_AUX_TRANSACTION_TIMER));
 
         /* [DP_TX]>>>STATE PENDING [Response ready]
-           Data available, pack it into response structure */
+           Data available, pack it into response structure and process it */
         getResponse();
-        dpTxData.stateCb = &processHandler;
+        processHandler();
+    } else if ((dpTxData.timeoutIrqFlag == 1U) || isDeadlineReached()) {
+        /* Sink did not reply in DP_AUX_TRANSACTION_TIMEOUT_US */
+        dpTxData.timeoutIrqFlag = 0U;
+        dpTxData.deadlineArmed = false;
+        timeoutHandler();
     } else {
-        /* Calculate time since reply transaction start */
-        timerVal = getTimerUsWithoutUpdate(DP_AUX_TRANSACTION_TIMER);
-        /* Check if timeout was reached */
-        if (timerVal >= DP_AUX_TRANSACTION_TIMEOUT_US) {
-            auxRxInProcess = false;
-            dpTxData.stateCb = &timeoutHandler;
-        }
+        waitForEvent();
     }
 }
 
 static void timeoutHandler(void) {
-  /* If number of replies was not exceeded, try again */
+
+    dpTxData.stats->timeoutCount++;
+
+    /* If number of replies was not exceeded, try again */
     if (dpTxData.timeoutCounter < DP_MAX_REPLY_TRIES) {
         /* [DP_TX]>>>STATE PENDING [Timeout counter [%d]] */
 
@@ -834,6 +1015,7 @@ static void timeoutHandler(void) {
         /* Cleanup interrupt flags to be sure that no previous interrupts will be used */
         dpTxData.rxDoneIrqFlag = 0U;
         dpTxData.txDoneIrqFlag = 0U;
+        dpTxData.timeoutIrqFlag = 0U;
 
         dpTxData.timeoutCounter++;
         dpTxData.stateCb = &resendHandler;
@@ -846,33 +1028,43 @@ static void timeoutHandler(void) {
 
 static void sendingHandler(void)
 {
-    uint32_t regVal;
-
     if (dpTxData.txDoneIrqFlag == 1U) {
 
-        startTimer(DP_AUX_TRANSACTION_TIMER);
+        /* Measure time of sending and restart timer for reply */
+        updateHistogram(dpTxData.stats->txDoneHist, getTimerUsWithUpdate(DP_AUX_TRANSACTION_TIMER));
 
         dpTxData.txDoneIrqFlag = 0U;
 
         /* Cleanup TX status registers */
         resetTx();
 
-        /* Go to state corresponding with RX response*/
+        /* Go to state corresponding with RX response, reply has own deadline */
+        dpTxData.deadlineArmed = false;
         dpTxData.stateCb = &waitForResponseHandler;
-    }
-    else {
-        /* Check if timeout was reached */
-        if (getTimerUsWithoutUpdate(DP_AUX_TRANSACTION_TIMER) > (uint32_t)DP_AUX_TRANSACTION_TIMEOUT_US) {
-            finishRequest();
-        }
+
+        /* RX_DONE could be already signaled, check it in the same dispatch */
+        waitForResponseHandler();
+
+    } else if (isDeadlineReached()) {
+        dpTxData.deadlineArmed = false;
+        dpTxData.stats->timeoutCount++;
+        finishRequest();
+    } else {
+        waitForEvent();
     }
 }
 
 static void resendHandler(void) {
+    dpTxData.stats->retryCount++;
+
     /* Try again to send same request */
     sendRequest();
 }
 
+static void sendNextHandler(void) {
+    sendRequest();
+}
+
 /**
  * Handler for plugged interrupt
  */
@@ -909,6 +1101,12 @@ static void plugInHandler(void)
 
         evCode = (uint8_t)DP_TX_EVENT_CODE_HPD_STATE_HIGH | (uint8_t)DP_TX_EVENT_CODE_HPD_HIGH;
         DP_TX_MAIL_HANDLER_notifyHpdEv(evCode);
+
+#ifndef USE_SINK_MODEL
+        /* Read discovery data before host asks for them. Not done with
+         * virtual sink, as its reads would be counted by sink_bench. */
+        DP_TX_SNAPSHOT_start();
+#endif // USE_SINK_MODEL
     }
 }
 
@@ -960,6 +1158,9 @@ static void DP_TX_init(void)
     dpTxData.plugged = false;
     dpTxData.txDoneIrqFlag = 0U;
     dpTxData.rxDoneIrqFlag = 0U;
+    dpTxData.timeoutIrqFlag = 0U;
+    dpTxData.stats = &dpTxStats.aux;
+    dpTxData.deadlineArmed = false;
 
     regVal = calculateClockRatio();
     RegWrite(DP_AUX_DIVIDE_2M, regVal);
@@ -973,9 +1174,11 @@ static void DP_TX_init(void)
     /* Clear RX and TX transactions registers */
     resetAux();
 
-    /* Stop timer */
-    regVal = RegFieldSet(DP_AUX_TIMER_STOP, AUX_HOST_STOP_TIMER, 0U);
-    RegWrite(DP_AUX_TIMER_STOP, regVal);
+    /* Set reply timeout of controller, timer is started by hardware after transmission */
+    regVal = RegFieldWrite(DP_AUX_TIMER_PRESET, AUX_HOST_TIMER_PRESET, 0U,
+                           DP_AUX_TRANSACTION_TIMEOUT_US * DP_AUX_TIMER_CLOCK_MHZ);
+    RegWrite(DP_AUX_TIMER_PRESET, regVal);
+    clearReplyTimer();
 
     /* Check if synchronization was achieved */
     checkSynchronization();
@@ -988,6 +1191,11 @@ bool DP_TX_isAvailable(void)
     return isAvail;
 }
 
+bool DP_TX_isPlugged(void)
+{
+    return dpTxData.plugged;
+}
+
 void DP_TX_connect(void)
 {
     /* Set plugIn interrupt flag */
@@ -1005,19 +1213,40 @@ void DP_TX_setRxFlag(void) {
     dpTxData.rxDoneIrqFlag = 1U;
 }
 
+void DP_TX_setTimeoutFlag(void)
+{
+    /* Set reply timer expired flag */
+    dpTxData.timeoutIrqFlag = 1U;
+}
+
 void DP_TX_disconnect(void)
 {
     /* Set unplugged interrupt flag */
     dpTxData.unpluggedIrqFlag = 1U;
 }
 
-void DP_TX_interrupt(void)
+DpTxSubmitStatus_t DP_TX_submitWhenFree(DpTxRequestData_t* request, ResponseCallback_t callback,
+                                        uint32_t elapsedMs, uint32_t timeoutMs)
 {
-    /* Call Hot-Plug policy interrupt handler */
-	uint8_t evCode = (uint8_t)DP_TX_EVENT_CODE_HPD_STATE_HIGH
-			       | (uint8_t)DP_TX_EVENT_CODE_HPD_PULSE;
+    DpTxSubmitStatus_t status;
+
+    if (DP_TX_isAvailable()) {
+        DP_TX_addRequest(request, callback);
+        status = DP_TX_SUBMIT_STATUS_SUBMITTED;
+    } else if (!dpTxData.plugged) {
+        status = DP_TX_SUBMIT_STATUS_NO_SINK;
+    } else if ((timeoutMs != DP_TX_SUBMIT_NO_TIMEOUT) && (elapsedMs > timeoutMs)) {
+        status = DP_TX_SUBMIT_STATUS_TIMEOUT;
+    } else {
+        status = DP_TX_SUBMIT_STATUS_WAITING;
+    }
 
-	DP_TX_MAIL_HANDLER_notifyHpdEv(evCode);
+    return status;
+}
+
+void DP_TX_waitRequestHandler(void)
+{
+    /* Nothing to do, state of client is changed by request callback */
 }
 
 void DP_TX_removeRequest(DpTxRequestData_t* request, ResponseCallback_t callback)
@@ -1026,12 +1255,14 @@ void DP_TX_removeRequest(DpTxRequestData_t* request, ResponseCallback_t callback
     dpTxData.requestData = request;
     dpTxData.transactionData.address = request->address;
     dpTxData.policyCallback = callback;
+    dpTxData.stats = getChannelStats(request->command);
 
     /* Clear status of transaction */
     dpTxData.motState = false;
     dpTxData.requestData->bytes_reply = 0U;
     dpTxData.timeoutCounter = 0U;
     dpTxData.deferCounter = 0U;
+    dpTxData.updateCounter = 0U;
     dpTxData.transactionDataCounter = 0U;
     dpTxData.dataCounter = 0U;
 
@@ -1045,11 +1276,13 @@ void DP_TX_addRequest(DpTxRequestData_t* request, ResponseCallback_t callback)
     dpTxData.transactionData.address = request->address;
     dpTxData.policyCallback = callback;
     dpTxData.transactionData.command = request->command;
+    dpTxData.stats = getChannelStats(request->command);
 
     /* Clear counters */
     dpTxData.requestData->bytes_reply = 0U;
     dpTxData.timeoutCounter = 0U;
     dpTxData.deferCounter = 0U;
+    dpTxData.updateCounter = 0U;
     dpTxData.transactionDataCounter = 0U;
 
     dpTxData.dataCounter = request->length;
@@ -1077,6 +1310,16 @@ void DP_TX_hdpInit(void)
     RegWrite(HPD_IRQ_DET_MAX_TIMER, regVal);
 }
 
+const DpTxStats_t* DP_TX_getStats(void)
+{
+    return &dpTxStats;
+}
+
+void DP_TX_resetStats(void)
+{
+    (void)memset(&dpTxStats, 0, sizeof(dpTxStats));
+}
+
 void DP_TX_InsertModule(void)
 {
     /* Have to be static to allow access from modRunner module */
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_irq.c
+ *
+ ******************************************************************************
+ */
+
+#include "dp_tx_irq.h"
+#include "dp_tx.h"
+#include "dp_tx_link_monitor.h"
+#include "dp_tx_mail_handler.h"
+#include "hdcp_tran.h"
+#include "hpd_events.h"
+#include "utils.h"
+#include "cdn_stdtypes.h"
+
+/* Indexes of vectors in buffer */
+#define DP_TX_IRQ_DEVICE_VECTOR 0U
+#define DP_TX_IRQ_LINK_VECTOR   1U
+#define DP_TX_IRQ_VECTORS_NUM   2U
+
+/* Pointer to function handling IRQ bits */
+typedef void (*IrqHandler_t)(void);
+
+/* Structure used to connect IRQ bits with handlers */
+typedef struct {
+    /* Index of vector */
+    uint8_t vector;
+    /* Mask of bits in vector */
+    uint8_t mask;
+    /* Handler called if any of bits is set */
+    IrqHandler_t handler;
+} IrqSubscriber_t;
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* State entered after request is finished */
+    StateCallback_t nextStateCb;
+    /* IRQ_HPD was detected and is not serviced yet */
+    bool irqPending;
+    /* Last request was finished with success */
+    bool requestOk;
+    /* Values of IRQ vectors */
+    uint8_t vectors[DP_TX_IRQ_VECTORS_NUM];
+    /* Request for DP_TX module */
+    DpTxRequestData_t request;
+    /* Position of module in ring of HPD events */
+    HpdEventsCursor_t hpdCursor;
+} DpTxIrqData_t;
+
+static DpTxIrqData_t dpTxIrqData;
+
+static void idleHandler(void);
+static void readLinkVectorHandler(void);
+static void ackDeviceVectorHandler(void);
+static void ackLinkVectorHandler(void);
+static void dispatchHandler(void);
+
+/**
+ * Callback of DP_TX request
+ * @param[in] reply, finished request
+ */
+static void requestCb(const DpTxRequestData_t* reply)
+{
+    dpTxIrqData.requestOk = (reply->bytes_reply == reply->length);
+    dpTxIrqData.stateCb = dpTxIrqData.nextStateCb;
+}
+
+/**
+ * Handler for state sending request to DP_TX module
+ */
+static void sendRequestHandler(void)
+{
+    switch (DP_TX_submitWhenFree(&dpTxIrqData.request, requestCb, 0U, DP_TX_SUBMIT_NO_TIMEOUT)) {
+    case DP_TX_SUBMIT_STATUS_SUBMITTED:
+        dpTxIrqData.stateCb = DP_TX_waitRequestHandler;
+        break;
+    case DP_TX_SUBMIT_STATUS_NO_SINK:
+        /* Sink was unplugged, IRQ is not serviced */
+        dpTxIrqData.stateCb = idleHandler;
+        break;
+    default:
+        /* Wait for DP_TX module */
+        break;
+    }
+}
+
+/**
+ * Prepare access to single IRQ vector, which is sent in next state
+ * @param[in] requestCode, DP_REQUEST_READ or DP_REQUEST_WRITE
+ * @param[in] vector, index of vector
+ * @param[in] nextState, state entered after request is finished
+ */
+static void setVectorRequest(DpRequest_t requestCode, uint8_t vector, StateCallback_t nextState)
+{
+    DpTxRequestData_t* request = &dpTxIrqData.request;
+
+    request->command = (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)requestCode;
+    request->address = (vector == DP_TX_IRQ_DEVICE_VECTOR)
+                     ? DPCD_DEVICE_SERVICE_IRQ_VECTOR_ADDR
+                     : DPCD_LINK_SERVICE_IRQ_VECTOR_ADDR;
+    request->length = 1U;
+    request->buffer = &dpTxIrqData.vectors[vector];
+    request->endTransaction = false;
+
+    dpTxIrqData.nextStateCb = nextState;
+    dpTxIrqData.stateCb = sendRequestHandler;
+}
+
+/**
+ * Notify link monitor about change of link status
+ */
+static void linkStatusChanged(void)
+{
+    DP_TX_LM_requestRead();
+}
+
+/**
+ * Handler for state dispatching IRQ bits to firmware modules and host
+ */
+static void dispatchHandler(void)
+{
+    /* Array with IRQ subscribers, other bits are handled by host only */
+    static const IrqSubscriber_t subscribers[] = {
+            {DP_TX_IRQ_DEVICE_VECTOR, DP_TX_IRQ_CP_IRQ, HDCP_TRAN_notifyCpIrq},
+            {DP_TX_IRQ_LINK_VECTOR, DP_TX_IRQ_LINK_STATUS_CHANGED, linkStatusChanged}
+    };
+
+    const uint8_t* vectors = dpTxIrqData.vectors;
+    uint8_t i;
+
+    for (i = 0U; i < (uint8_t)(sizeof(subscribers) / sizeof(subscribers[0])); i++) {
+        if ((vectors[subscribers[i].vector] & subscribers[i].mask) != 0U) {
+            (subscribers[i].handler)();
+        }
+    }
+
+    /* Sinks without ESI registers signal change of link status
+     * by IRQ_HPD with empty DEVICE_SERVICE_IRQ_VECTOR */
+    if ((vectors[DP_TX_IRQ_DEVICE_VECTOR] == 0U) && (vectors[DP_TX_IRQ_LINK_VECTOR] == 0U)) {
+        linkStatusChanged();
+    }
+
+    DP_TX_MAIL_HANDLER_notifyIrqEv(vectors[DP_TX_IRQ_DEVICE_VECTOR], vectors[DP_TX_IRQ_LINK_VECTOR]);
+
+    dpTxIrqData.stateCb = idleHandler;
+}
+
+/**
+ * Handler for state acknowledging LINK_SERVICE_IRQ_VECTOR_ESI0
+ */
+static void ackLinkVectorHandler(void)
+{
+    if (dpTxIrqData.vectors[DP_TX_IRQ_LINK_VECTOR] != 0U) {
+        /* Bits are cleared by writing 1 */
+        setVectorRequest(DP_REQUEST_WRITE, DP_TX_IRQ_LINK_VECTOR, dispatchHandler);
+    } else {
+        dispatchHandler();
+    }
+}
+
+/**
+ * Handler for state acknowledging DEVICE_SERVICE_IRQ_VECTOR
+ */
+static void ackDeviceVectorHandler(void)
+{
+    /* Register is optional (DPCD 1.2 and newer), failed read means no bits */
+    if (!dpTxIrqData.requestOk) {
+        dpTxIrqData.vectors[DP_TX_IRQ_LINK_VECTOR] = 0U;
+    }
+
+    if (dpTxIrqData.vectors[DP_TX_IRQ_DEVICE_VECTOR] != 0U) {
+        /* Bits are cleared by writing 1 */
+        setVectorRequest(DP_REQUEST_WRITE, DP_TX_IRQ_DEVICE_VECTOR, ackLinkVectorHandler);
+    } else {
+        ackLinkVectorHandler();
+    }
+}
+
+/**
+ * Handler for state reading LINK_SERVICE_IRQ_VECTOR_ESI0
+ */
+static void readLinkVectorHandler(void)
+{
+    if (!dpTxIrqData.requestOk) {
+        /* Host is notified anyway, it may read vector on its own */
+        dpTxIrqData.vectors[DP_TX_IRQ_DEVICE_VECTOR] = 0U;
+        dpTxIrqData.vectors[DP_TX_IRQ_LINK_VECTOR] = 0U;
+        DP_TX_MAIL_HANDLER_notifyIrqEv(0U, 0U);
+        dpTxIrqData.stateCb = idleHandler;
+    } else {
+        setVectorRequest(DP_REQUEST_READ, DP_TX_IRQ_LINK_VECTOR, ackDeviceVectorHandler);
+    }
+}
+
+/**
+ * Handler for state waiting for IRQ_HPD
+ */
+static void idleHandler(void)
+{
+    HpdEvent_t event;
+
+    while (HPD_EVENTS_pop(&dpTxIrqData.hpdCursor, &event)) {
+        if (event.type == HPD_EVENT_IRQ) {
+            /* IRQs detected before service are handled together */
+            dpTxIrqData.irqPending = true;
+        } else {
+            /* Pending IRQ belongs to previous sink */
+            dpTxIrqData.irqPending = false;
+        }
+    }
+
+    if (dpTxIrqData.irqPending) {
+        dpTxIrqData.irqPending = false;
+        setVectorRequest(DP_REQUEST_READ, DP_TX_IRQ_DEVICE_VECTOR, readLinkVectorHandler);
+    }
+}
+
+/**
+ * Main thread of DP_TX_IRQ module
+ */
+static void DP_TX_IRQ_thread(void)
+{
+    (*dpTxIrqData.stateCb)();
+}
+
+/**
+ * Function used to start DP_TX_IRQ module
+ */
+static void DP_TX_IRQ_start(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize DP_TX_IRQ module
+ */
+static void DP_TX_IRQ_init(void)
+{
+    HPD_EVENTS_initCursor(&dpTxIrqData.hpdCursor);
+    dpTxIrqData.irqPending = false;
+    dpTxIrqData.stateCb = idleHandler;
+}
+
+void DP_TX_IRQ_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t dpTxIrqModule;
+
+    /* Assign thread functions into pointers */
+    dpTxIrqModule.initTask = &DP_TX_IRQ_init;
+    dpTxIrqModule.startTask = &DP_TX_IRQ_start;
+    dpTxIrqModule.thread = &DP_TX_IRQ_thread;
+
+    dpTxIrqModule.moduleId = MODRUNNER_MODULE_DP_TX_IRQ;
+
+    /* Set priority of module */
+    dpTxIrqModule.pPriority = 0U;
+
+    /* Attach module to system */
+    modRunnerInsertModule(&dpTxIrqModule);
+}
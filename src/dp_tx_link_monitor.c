@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_link_monitor.c
+ *
+ ******************************************************************************
+ */
+
+#include "dp_tx_link_monitor.h"
+#include "dp_tx.h"
+#include "dp_tx_link_training.h"
+#include "dp_tx_mail_handler.h"
+#include "hpd_events.h"
+#include "timer.h"
+#include "utils.h"
+#include "cdn_stdtypes.h"
+
+#include <string.h>
+
+/* Address of LANE0_1_STATUS DPCD register */
+#define DPCD_LANE0_1_STATUS_ADDR 0x00202U
+
+/* Maximum number of changes reported to host */
+#define DP_TX_LM_MAX_CHANGES 0xFFU
+
+/* Bits of lane status block compared by monitor: CR_DONE, EQ_DONE and
+ * SYMBOL_LOCKED of each lane and INTERLANE_ALIGN_DONE. Sink status and
+ * adjust requests are ignored. */
+static const uint8_t monitoredBits[DP_TX_LT_LANE_STATUS_SIZE] = { 0x77U, 0x77U, 0x01U, 0x00U, 0x00U, 0x00U };
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* Period of reads in milliseconds, 0 if monitor is disabled */
+    uint16_t intervalMs;
+    /* Read of link status is requested */
+    bool readPending;
+    /* Reference status was read since monitor was enabled or sink was plugged */
+    bool isStatusValid;
+    /* Lane status reported by the latest event */
+    uint8_t status[DP_TX_LT_LANE_STATUS_SIZE];
+    /* Buffer for read lane status */
+    uint8_t buffer[DP_TX_LT_LANE_STATUS_SIZE];
+    /* Number of changes not read by host */
+    uint8_t changes;
+    /* Request for DP_TX module */
+    DpTxRequestData_t request;
+    /* Position of monitor in ring of HPD events */
+    HpdEventsCursor_t hpdCursor;
+} DpTxLmData_t;
+
+static DpTxLmData_t dpTxLmData;
+
+static void idleHandler(void);
+
+/**
+ * Check if monitored bits of read status differ from reported status
+ * @return 'true' if changed or 'false' if not
+ */
+static bool isStatusChanged(void)
+{
+    bool isChanged = false;
+    uint8_t i;
+
+    for (i = 0U; i < DP_TX_LT_LANE_STATUS_SIZE; i++) {
+        if (((dpTxLmData.buffer[i] ^ dpTxLmData.status[i]) & monitoredBits[i]) != 0U) {
+            isChanged = true;
+        }
+    }
+
+    return isChanged;
+}
+
+/**
+ * Callback of DP_TX request reading link status
+ * @param[in] reply, finished request
+ */
+static void readStatusCb(const DpTxRequestData_t* reply)
+{
+    /* Failed read (e.g. due to unplug) is ignored, status is read again in next period */
+    if (reply->bytes_reply == reply->length) {
+        if (!dpTxLmData.isStatusValid) {
+            /* First read gives reference status */
+            (void)memcpy(dpTxLmData.status, dpTxLmData.buffer, DP_TX_LT_LANE_STATUS_SIZE);
+            dpTxLmData.isStatusValid = true;
+        } else if (isStatusChanged()) {
+            (void)memcpy(dpTxLmData.status, dpTxLmData.buffer, DP_TX_LT_LANE_STATUS_SIZE);
+            if (dpTxLmData.changes < DP_TX_LM_MAX_CHANGES) {
+                dpTxLmData.changes++;
+            }
+            DP_TX_MAIL_HANDLER_notifyLinkStatusEv();
+        } else {
+            /* Nothing changed, host is not notified */
+        }
+    }
+
+    dpTxLmData.stateCb = idleHandler;
+}
+
+/**
+ * Update request flags due to HPD events
+ */
+static void processHpdEvents(void)
+{
+    HpdEvent_t event;
+
+    while (HPD_EVENTS_pop(&dpTxLmData.hpdCursor, &event)) {
+        /* IRQ_HPD is handled by DP_TX_IRQ module */
+        if (event.type != HPD_EVENT_IRQ) {
+            /* New sink, reference status has to be read again */
+            dpTxLmData.isStatusValid = false;
+        }
+    }
+}
+
+/**
+ * Handler for state waiting for next read
+ */
+static void idleHandler(void)
+{
+    processHpdEvents();
+
+    if (dpTxLmData.intervalMs != 0U) {
+        if (getTimerMsWithoutUpdate(DP_TX_LINK_MONITOR_TIMER) >= dpTxLmData.intervalMs) {
+            dpTxLmData.readPending = true;
+        }
+
+        /* Status is changing during link training, so monitor is paused */
+        if (dpTxLmData.readPending && !DP_TX_LT_isBusy()) {
+            dpTxLmData.request.command = (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ;
+            dpTxLmData.request.address = DPCD_LANE0_1_STATUS_ADDR;
+            dpTxLmData.request.length = DP_TX_LT_LANE_STATUS_SIZE;
+            dpTxLmData.request.buffer = dpTxLmData.buffer;
+            dpTxLmData.request.endTransaction = false;
+
+            /* Read stays pending while DP_TX module is busy or sink is unplugged */
+            if (DP_TX_submitWhenFree(&dpTxLmData.request, readStatusCb, 0U, DP_TX_SUBMIT_NO_TIMEOUT)
+                == DP_TX_SUBMIT_STATUS_SUBMITTED) {
+                dpTxLmData.readPending = false;
+                startTimer(DP_TX_LINK_MONITOR_TIMER);
+                dpTxLmData.stateCb = DP_TX_waitRequestHandler;
+            }
+        }
+    } else {
+        dpTxLmData.readPending = false;
+    }
+}
+
+/**
+ * Main thread of DP_TX_LM module
+ */
+static void DP_TX_LM_thread(void)
+{
+    (*dpTxLmData.stateCb)();
+}
+
+/**
+ * Function used to start DP_TX_LM module
+ */
+static void DP_TX_LM_start(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize DP_TX_LM module
+ */
+static void DP_TX_LM_init(void)
+{
+    (void)memset(&dpTxLmData, 0, sizeof(dpTxLmData));
+    HPD_EVENTS_initCursor(&dpTxLmData.hpdCursor);
+    dpTxLmData.stateCb = idleHandler;
+}
+
+void DP_TX_LM_setInterval(uint16_t intervalMs)
+{
+    if ((dpTxLmData.intervalMs == 0U) && (intervalMs != 0U)) {
+        /* Read reference status right after enabling */
+        dpTxLmData.isStatusValid = false;
+        dpTxLmData.readPending = true;
+        startTimer(DP_TX_LINK_MONITOR_TIMER);
+    }
+
+    dpTxLmData.intervalMs = intervalMs;
+}
+
+void DP_TX_LM_requestRead(void)
+{
+    dpTxLmData.readPending = (dpTxLmData.intervalMs != 0U);
+}
+
+uint8_t DP_TX_LM_getStatus(uint8_t* status)
+{
+    uint8_t changes = dpTxLmData.changes;
+
+    (void)memcpy(status, dpTxLmData.status, DP_TX_LT_LANE_STATUS_SIZE);
+    dpTxLmData.changes = 0U;
+
+    return changes;
+}
+
+void DP_TX_LM_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t dpTxLmModule;
+
+    /* Assign thread functions into pointers */
+    dpTxLmModule.initTask = &DP_TX_LM_init;
+    dpTxLmModule.startTask = &DP_TX_LM_start;
+    dpTxLmModule.thread = &DP_TX_LM_thread;
+
+    dpTxLmModule.moduleId = MODRUNNER_MODULE_DP_TX_LINK_MONITOR;
+
+    /* Set priority of module */
+    dpTxLmModule.pPriority = 0U;
+
+    /* Attach module to system */
+    modRunnerInsertModule(&dpTxLmModule);
+}
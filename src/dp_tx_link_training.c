@@ -0,0 +1,905 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_link_training.c
+ *
+ ******************************************************************************
+ */
+
+#include "dp_tx_link_training.h"
+#include "dp_tx.h"
+#include "dp_tx_mail_handler.h"
+#include "timer.h"
+#include "utils.h"
+#include "reg.h"
+#include "cdn_stdtypes.h"
+
+#include <string.h>
+
+/* Address of DPCD registers (chapter 2.9.3 of DP specification) */
+#define DPCD_RECEIVER_CAP_ADDR          0x00000U
+#define DPCD_LINK_BW_SET_ADDR           0x00100U
+#define DPCD_TRAINING_PATTERN_SET_ADDR  0x00102U
+#define DPCD_TRAINING_LANE0_SET_ADDR    0x00103U
+#define DPCD_DOWNSPREAD_CTRL_ADDR       0x00107U
+#define DPCD_LANE0_1_STATUS_ADDR        0x00202U
+#define DPCD_SINK_IEEE_OUI_ADDR         0x00400U
+
+/* Number of sink identification bytes (OUI, device ID string, HW and FW revision) */
+#define DP_TX_LT_SINK_ID_SIZE 12U
+
+/* Number of receiver capability bytes read before training (000h-00Eh) */
+#define DP_TX_LT_CAPS_SIZE 15U
+/* Offsets of fields in receiver capability */
+#define DP_TX_LT_CAPS_MAX_LINK_RATE   0x01U
+#define DP_TX_LT_CAPS_MAX_LANE_COUNT  0x02U
+#define DP_TX_LT_CAPS_MAX_DOWNSPREAD  0x03U
+#define DP_TX_LT_CAPS_AUX_RD_INTERVAL 0x0EU
+/* Masks of fields in receiver capability */
+#define DP_TX_LT_MAX_LANE_COUNT_MASK   0x1FU
+#define DP_TX_LT_TPS3_SUPPORTED_MASK   0x40U
+#define DP_TX_LT_ENHANCED_FRAME_MASK   0x80U
+#define DP_TX_LT_TPS4_SUPPORTED_MASK   0x80U
+#define DP_TX_LT_MAX_DOWNSPREAD_MASK   0x01U
+#define DP_TX_LT_AUX_RD_INTERVAL_MASK  0x7FU
+
+/* Values of TRAINING_PATTERN_SET register */
+#define DP_TX_LT_PATTERN_DISABLE      0x00U
+#define DP_TX_LT_PATTERN_TPS4         0x07U
+#define DP_TX_LT_SCRAMBLING_DISABLE   0x20U
+/* Numbers of training patterns */
+#define DP_TX_LT_TPS1 1U
+#define DP_TX_LT_TPS2 2U
+#define DP_TX_LT_TPS3 3U
+#define DP_TX_LT_TPS4 4U
+
+/* Fields of TRAINING_LANEx_SET register */
+#define DP_TX_LT_SWING_MASK            0x03U
+#define DP_TX_LT_MAX_SWING_REACHED     0x04U
+#define DP_TX_LT_PRE_EMPH_OFFSET       3U
+#define DP_TX_LT_MAX_PRE_EMPH_REACHED  0x20U
+/* Maximum sum of voltage swing and pre-emphasis levels */
+#define DP_TX_LT_MAX_LEVEL 3U
+
+/* Fields of LANEx_y_STATUS and ADJUST_REQUEST_LANEx_y registers (4 bits per lane) */
+#define DP_TX_LT_LANE_CR_DONE        0x01U
+#define DP_TX_LT_LANE_EQ_DONE        0x02U
+#define DP_TX_LT_LANE_SYMBOL_LOCKED  0x04U
+#define DP_TX_LT_LANE_BITS           4U
+#define DP_TX_LT_LANE_MASK           0x0FU
+#define DP_TX_LT_ADJUST_PRE_OFFSET   2U
+/* INTERLANE_ALIGN_DONE bit of LANE_ALIGN_STATUS_UPDATED register */
+#define DP_TX_LT_INTERLANE_ALIGN_DONE 0x01U
+/* Offsets of registers in lane status block read from 202h */
+#define DP_TX_LT_ALIGN_STATUS_OFFSET 2U
+#define DP_TX_LT_ADJUST_OFFSET       4U
+
+/* Enhanced framing bit of LANE_COUNT_SET register */
+#define DP_TX_LT_ENHANCED_FRAME_EN 0x80U
+/* SPREAD_AMP bit of DOWNSPREAD_CTRL register (0.5% down-spread) */
+#define DP_TX_LT_SPREAD_AMP 0x10U
+/* SET_ANSI_8B10B value of MAIN_LINK_CHANNEL_CODING_SET register */
+#define DP_TX_LT_CODING_8B10B 0x01U
+
+/* Lowest link rate (RBR, 1.62 Gbps) */
+#define DP_TX_LT_RATE_RBR 0x06U
+
+/* Offset between lane fields in PMA_TX_VMARGIN and PMA_TX_DEEMPH registers */
+#define DP_TX_LT_PMA_LANE_OFFSET 8U
+
+/* Time between setting training pattern and reading status during clock recovery */
+#define DP_TX_LT_CR_INTERVAL_US 100U
+/* Time between setting training pattern and reading status during equalization
+ * if TRAINING_AUX_RD_INTERVAL is 0, otherwise register value is used in 4 ms units */
+#define DP_TX_LT_EQ_INTERVAL_US 400U
+#define DP_TX_LT_AUX_RD_INTERVAL_UNIT_US 4000U
+/* Clock recovery fails if voltage swing was the same for 5 iterations */
+#define DP_TX_LT_MAX_SAME_SWING 5U
+/* Maximum number of clock recovery iterations for single lane configuration */
+#define DP_TX_LT_MAX_CR_LOOPS 10U
+/* Maximum number of channel equalization iterations for single lane configuration */
+#define DP_TX_LT_MAX_EQ_LOOPS 5U
+/* Training is aborted if DP_TX module is not available in given time */
+#define DP_TX_LT_TIMEOUT_MS 1000U
+
+/* Number of sinks with remembered training result */
+#define DP_TX_LT_CACHE_SIZE 4U
+/* Parameters of FNV-1a hash used to identify sink */
+#define DP_TX_LT_FNV_OFFSET_BASIS 0x811C9DC5U
+#define DP_TX_LT_FNV_PRIME        0x01000193U
+
+/**
+ * Result of successful training remembered for a sink
+ */
+typedef struct
+{
+    /* Entry is used */
+    bool valid;
+    /* Hash of receiver capability and sink identification */
+    uint32_t sinkHash;
+    /* Trained link rate */
+    uint8_t linkRate;
+    /* Trained number of lanes */
+    uint8_t laneCount;
+    /* Enhanced framing was enabled */
+    bool enhancedFraming;
+    /* Values of TRAINING_LANEx_SET DPCD registers */
+    uint8_t laneSet[DP_TX_LT_MAX_LANES];
+} DpTxLtCacheEntry_t;
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* State entered after AUX request is finished */
+    StateCallback_t nextStateCb;
+    /* Parameters given by host */
+    DpTxLtParams_t params;
+    /* Result of training */
+    DpTxLtResult_t result;
+    /* Request for DP_TX module */
+    DpTxRequestData_t request;
+    /* Callback of request for DP_TX module */
+    ResponseCallback_t requestCb;
+    /* Buffer for receiver capability and written DPCD data */
+    uint8_t buffer[DP_TX_LT_CAPS_SIZE];
+    /* Training pattern used during equalization (TPS2, TPS3 or TPS4) */
+    uint8_t eqPattern;
+    /* Time between setting training pattern and reading status during equalization */
+    uint32_t eqIntervalUs;
+    /* Enhanced framing enabled */
+    bool enhancedFraming;
+    /* Down-spread enabled (supported by sink) */
+    bool downspread;
+    /* Number of lanes supported by both sides */
+    uint8_t maxLaneCount;
+    /* Number of iterations in current phase */
+    uint8_t loops;
+    /* Number of clock recovery iterations with the same voltage swing */
+    uint8_t sameSwingLoops;
+    /* Sink identification (DPCD 400h-40Bh) */
+    uint8_t sinkId[DP_TX_LT_SINK_ID_SIZE];
+    /* Sink identification was read */
+    bool sinkIdValid;
+    /* Hash of receiver capability and sink identification */
+    uint32_t sinkHash;
+    /* Remembered results of successful trainings */
+    DpTxLtCacheEntry_t cache[DP_TX_LT_CACHE_SIZE];
+    /* Index of cache entry replaced by next new sink */
+    uint8_t cacheNext;
+    /* Cache entry used by current training, NULL if full training is done */
+    DpTxLtCacheEntry_t* cacheEntry;
+} DpTxLtData_t;
+
+static DpTxLtData_t dpTxLtData;
+
+static void configureLinkHandler(void);
+static void capsHandler(void);
+static void crWaitHandler(void);
+static void crCheckHandler(void);
+static void eqWaitHandler(void);
+static void eqCheckHandler(void);
+static void doneHandler(void);
+
+/**
+ * Finish training without further AUX transactions
+ * @param[in] status, status of training
+ */
+static void abortTraining(DpTxLtStatus_t status)
+{
+    dpTxLtData.result.status = status;
+    dpTxLtData.stateCb = doneHandler;
+}
+
+/**
+ * Callback of DP_TX request
+ * @param[in] reply, finished request
+ */
+static void requestCb(const DpTxRequestData_t* reply)
+{
+    if (reply->bytes_reply != reply->length) {
+        /* AUX failure or unplug */
+        abortTraining(DP_TX_LT_STATUS_ABORTED);
+    } else {
+        dpTxLtData.stateCb = dpTxLtData.nextStateCb;
+    }
+}
+
+/**
+ * Callback of DP_TX request reading sink identification. Failure is not
+ * critical, only cached settings are not used.
+ * @param[in] reply, finished request
+ */
+static void sinkIdCb(const DpTxRequestData_t* reply)
+{
+    dpTxLtData.sinkIdValid = (reply->bytes_reply == reply->length);
+    dpTxLtData.stateCb = capsHandler;
+}
+
+/**
+ * Handler for state sending request to DP_TX module
+ */
+static void sendRequestHandler(void)
+{
+    switch (DP_TX_submitWhenFree(&dpTxLtData.request, dpTxLtData.requestCb,
+                                 getTimerMsWithoutUpdate(DP_TX_LT_WAIT_TIMER), DP_TX_LT_TIMEOUT_MS)) {
+    case DP_TX_SUBMIT_STATUS_SUBMITTED:
+        dpTxLtData.stateCb = DP_TX_waitRequestHandler;
+        break;
+    case DP_TX_SUBMIT_STATUS_NO_SINK:
+    case DP_TX_SUBMIT_STATUS_TIMEOUT:
+        abortTraining(DP_TX_LT_STATUS_ABORTED);
+        break;
+    default:
+        /* Wait for DP_TX module */
+        break;
+    }
+}
+
+/**
+ * Prepare DPCD request, which is sent in next state
+ * @param[in] requestCode, DP_REQUEST_READ or DP_REQUEST_WRITE
+ * @param[in] address, DPCD address
+ * @param[in] length, number of bytes to read/write
+ * @param[in] buffer, buffer for read data or with data to write
+ * @param[in] nextState, state entered after request is finished
+ */
+static void setDpcdRequest(DpRequest_t requestCode, uint32_t address, uint32_t length,
+                           uint8_t* buffer, StateCallback_t nextState)
+{
+    DpTxRequestData_t* request = &dpTxLtData.request;
+
+    request->command = (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)requestCode;
+    request->address = address;
+    request->length = length;
+    request->buffer = buffer;
+    request->endTransaction = false;
+
+    dpTxLtData.requestCb = requestCb;
+    dpTxLtData.nextStateCb = nextState;
+    startTimer(DP_TX_LT_WAIT_TIMER);
+    dpTxLtData.stateCb = sendRequestHandler;
+}
+
+/**
+ * Prepare write of training pattern and TRAINING_LANEx_SET registers
+ * @param[in] pattern, value of TRAINING_PATTERN_SET register
+ * @param[in] nextState, state entered after request is finished
+ */
+static void setTrainingPatternRequest(uint8_t pattern, StateCallback_t nextState)
+{
+    uint8_t laneCount = dpTxLtData.result.laneCount;
+
+    dpTxLtData.buffer[0] = pattern;
+    (void)memcpy(&dpTxLtData.buffer[1], dpTxLtData.result.laneSet, laneCount);
+
+    setDpcdRequest(DP_REQUEST_WRITE, DPCD_TRAINING_PATTERN_SET_ADDR, (uint32_t)laneCount + 1U,
+                   dpTxLtData.buffer, nextState);
+}
+
+/**
+ * Prepare write of TRAINING_LANEx_SET registers
+ * @param[in] nextState, state entered after request is finished
+ */
+static void setLaneSetRequest(StateCallback_t nextState)
+{
+    (void)memcpy(dpTxLtData.buffer, dpTxLtData.result.laneSet, dpTxLtData.result.laneCount);
+
+    setDpcdRequest(DP_REQUEST_WRITE, DPCD_TRAINING_LANE0_SET_ADDR, dpTxLtData.result.laneCount,
+                   dpTxLtData.buffer, nextState);
+}
+
+/**
+ * Configure number of lanes and framing mode of source
+ */
+static void setSourceLanes(void)
+{
+    uint8_t laneCount = dpTxLtData.result.laneCount;
+    uint32_t regVal;
+
+    regVal = RegFieldWrite(DPTX_LANE_EN, DPTX_LANE_ENABLE, 0U, ((uint32_t)1U << laneCount) - 1U);
+    RegWrite(DPTX_LANE_EN, regVal);
+
+    regVal = RegRead(DP_FRAMER_GLOBAL_CONFIG);
+    regVal = RegFieldWrite(DP_FRAMER_GLOBAL_CONFIG, NUM_LANES, regVal, (uint32_t)laneCount - 1U);
+    RegWrite(DP_FRAMER_GLOBAL_CONFIG, regVal);
+
+    regVal = RegFieldWrite(DPTX_ENHNCD, DPTX_ENHANCED_MODE, 0U, bool_to_uint(dpTxLtData.enhancedFraming));
+    RegWrite(DPTX_ENHNCD, regVal);
+}
+
+/**
+ * Set training pattern transmitted by source
+ * @param[in] pattern, number of training pattern (0 disables training)
+ */
+static void setSourcePattern(uint8_t pattern)
+{
+    uint32_t regVal = RegRead(DP_TX_PHY_CONFIG_REG);
+
+    regVal = RegFieldWrite(DP_TX_PHY_CONFIG_REG, DP_TX_PHY_TRAINING_ENABLE, regVal, bool_to_uint(pattern != 0U));
+    regVal = RegFieldWrite(DP_TX_PHY_CONFIG_REG, DP_TX_PHY_TRAINING_TYPE, regVal, pattern);
+    /* TPS4 and video are scrambled */
+    regVal = RegFieldWrite(DP_TX_PHY_CONFIG_REG, DP_TX_PHY_SCRAMBLER_BYPASS, regVal,
+                           bool_to_uint((pattern != 0U) && (pattern != DP_TX_LT_TPS4)));
+    RegWrite(DP_TX_PHY_CONFIG_REG, regVal);
+}
+
+/**
+ * Set voltage swing and pre-emphasis of source lanes due to TRAINING_LANEx_SET values
+ */
+static void setSourceDrive(void)
+{
+    uint32_t vmargin = 0U;
+    uint32_t deemph = 0U;
+    uint32_t offset;
+    uint8_t laneSet;
+    uint8_t lane;
+
+    for (lane = 0U; lane < dpTxLtData.result.laneCount; lane++) {
+        laneSet = dpTxLtData.result.laneSet[lane];
+        offset = (uint32_t)lane * DP_TX_LT_PMA_LANE_OFFSET;
+        vmargin |= ((uint32_t)laneSet & DP_TX_LT_SWING_MASK) << offset;
+        deemph |= (((uint32_t)laneSet >> DP_TX_LT_PRE_EMPH_OFFSET) & DP_TX_LT_SWING_MASK) << offset;
+    }
+
+    RegWrite(PMA_TX_VMARGIN, vmargin);
+    RegWrite(PMA_TX_DEEMPH, deemph);
+}
+
+/**
+ * Get 4-bit lane field from lane status block
+ * @param[in] offset, offset of register pair in lane status block
+ * @param[in] lane, lane number
+ * @return lane field
+ */
+static inline uint8_t getLaneField(uint8_t offset, uint8_t lane)
+{
+    uint8_t regVal = dpTxLtData.result.laneStatus[offset + (lane >> 1)];
+    return (regVal >> ((lane & 1U) * DP_TX_LT_LANE_BITS)) & DP_TX_LT_LANE_MASK;
+}
+
+/**
+ * Check if status bits are set for all active lanes
+ * @param[in] mask, mask of lane status bits
+ * @return 'true' if set for all lanes or 'false' if not
+ */
+static bool isLaneStatusSet(uint8_t mask)
+{
+    bool isSet = true;
+    uint8_t lane;
+
+    for (lane = 0U; lane < dpTxLtData.result.laneCount; lane++) {
+        if ((getLaneField(0U, lane) & mask) != mask) {
+            isSet = false;
+            break;
+        }
+    }
+
+    return isSet;
+}
+
+/**
+ * Check if maximum voltage swing was reached on any lane
+ * @return 'true' if reached or 'false' if not
+ */
+static bool isMaxSwingReached(void)
+{
+    bool isReached = false;
+    uint8_t lane;
+
+    for (lane = 0U; lane < dpTxLtData.result.laneCount; lane++) {
+        if ((dpTxLtData.result.laneSet[lane] & DP_TX_LT_MAX_SWING_REACHED) != 0U) {
+            isReached = true;
+        }
+    }
+
+    return isReached;
+}
+
+/**
+ * Update TRAINING_LANEx_SET values due to adjustments requested by sink,
+ * limited to levels supported by source
+ * @return 'true' if voltage swing of any lane was changed or 'false' if not
+ */
+static bool adjustDrive(void)
+{
+    bool swingChanged = false;
+    uint8_t maxPreEmphasis;
+    uint8_t preEmphasis;
+    uint8_t request;
+    uint8_t laneSet;
+    uint8_t swing;
+    uint8_t lane;
+
+    for (lane = 0U; lane < dpTxLtData.result.laneCount; lane++) {
+        request = getLaneField(DP_TX_LT_ADJUST_OFFSET, lane);
+        swing = get_minimum(request & DP_TX_LT_SWING_MASK, dpTxLtData.params.maxVoltageSwing);
+
+        /* Sum of voltage swing and pre-emphasis levels cannot exceed 3 */
+        maxPreEmphasis = get_minimum(dpTxLtData.params.maxPreEmphasis, DP_TX_LT_MAX_LEVEL - swing);
+        preEmphasis = get_minimum((request >> DP_TX_LT_ADJUST_PRE_OFFSET) & DP_TX_LT_SWING_MASK, maxPreEmphasis);
+
+        laneSet = swing | (uint8_t)(preEmphasis << DP_TX_LT_PRE_EMPH_OFFSET);
+        if (swing == dpTxLtData.params.maxVoltageSwing) {
+            laneSet |= DP_TX_LT_MAX_SWING_REACHED;
+        }
+        if (preEmphasis == maxPreEmphasis) {
+            laneSet |= DP_TX_LT_MAX_PRE_EMPH_REACHED;
+        }
+
+        if ((laneSet & DP_TX_LT_SWING_MASK) != (dpTxLtData.result.laneSet[lane] & DP_TX_LT_SWING_MASK)) {
+            swingChanged = true;
+        }
+
+        dpTxLtData.result.laneSet[lane] = laneSet;
+    }
+
+    setSourceDrive();
+
+    return swingChanged;
+}
+
+/**
+ * Calculate hash identifying sink from receiver capability and sink identification
+ * @return hash value
+ */
+static uint32_t getSinkHash(void)
+{
+    uint32_t hash = DP_TX_LT_FNV_OFFSET_BASIS;
+    uint8_t i;
+
+    for (i = 0U; i < DP_TX_LT_CAPS_SIZE; i++) {
+        hash = (hash ^ dpTxLtData.buffer[i]) * DP_TX_LT_FNV_PRIME;
+    }
+
+    for (i = 0U; i < DP_TX_LT_SINK_ID_SIZE; i++) {
+        hash = (hash ^ dpTxLtData.sinkId[i]) * DP_TX_LT_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * Find cache entry of current sink
+ * @return pointer to entry or NULL if sink is not remembered
+ */
+static DpTxLtCacheEntry_t* findCacheEntry(void)
+{
+    DpTxLtCacheEntry_t* entry = NULL;
+    uint8_t i;
+
+    for (i = 0U; i < DP_TX_LT_CACHE_SIZE; i++) {
+        if (dpTxLtData.cache[i].valid && (dpTxLtData.cache[i].sinkHash == dpTxLtData.sinkHash)) {
+            entry = &dpTxLtData.cache[i];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+/**
+ * Get cache entry of current sink, which can be used by current training
+ * @return pointer to entry or NULL if full training has to be done
+ */
+static DpTxLtCacheEntry_t* getUsableCacheEntry(void)
+{
+    DpTxLtCacheEntry_t* entry = NULL;
+
+    if (dpTxLtData.params.useCache && dpTxLtData.sinkIdValid) {
+        entry = findCacheEntry();
+    }
+
+    /* Remembered configuration must match requested one */
+    if ((entry != NULL)
+            && ((entry->linkRate != dpTxLtData.result.linkRate)
+             || (entry->laneCount > dpTxLtData.maxLaneCount)
+             || (entry->enhancedFraming != dpTxLtData.enhancedFraming))) {
+        entry = NULL;
+    }
+
+    return entry;
+}
+
+/**
+ * Remember result of successful training for current sink
+ */
+static void storeCacheEntry(void)
+{
+    DpTxLtCacheEntry_t* entry = findCacheEntry();
+
+    if (entry == NULL) {
+        /* Replace the oldest entry */
+        entry = &dpTxLtData.cache[dpTxLtData.cacheNext];
+        dpTxLtData.cacheNext = (dpTxLtData.cacheNext + 1U) % (uint8_t)DP_TX_LT_CACHE_SIZE;
+    }
+
+    entry->valid = true;
+    entry->sinkHash = dpTxLtData.sinkHash;
+    entry->linkRate = dpTxLtData.result.linkRate;
+    entry->laneCount = dpTxLtData.result.laneCount;
+    entry->enhancedFraming = dpTxLtData.enhancedFraming;
+    (void)memcpy(entry->laneSet, dpTxLtData.result.laneSet, sizeof(entry->laneSet));
+}
+
+/**
+ * Disable training pattern on both sides and finish training
+ * @param[in] status, status of training
+ */
+static void finishTraining(DpTxLtStatus_t status)
+{
+    dpTxLtData.result.status = status;
+
+    if ((status == DP_TX_LT_STATUS_SUCCESS) && dpTxLtData.sinkIdValid) {
+        storeCacheEntry();
+    }
+
+    setSourcePattern(0U);
+
+    dpTxLtData.buffer[0] = DP_TX_LT_PATTERN_DISABLE;
+    setDpcdRequest(DP_REQUEST_WRITE, DPCD_TRAINING_PATTERN_SET_ADDR, 1U, dpTxLtData.buffer, doneHandler);
+}
+
+/**
+ * Retrain with lower number of lanes if possible. Rate can't be changed by
+ * firmware (PHY PLL is configured by host), so host is asked to reduce it.
+ * @param[in] status, status of training if fallback is not possible
+ */
+static void fallback(DpTxLtStatus_t status)
+{
+    if (dpTxLtData.result.laneCount > 1U) {
+        dpTxLtData.result.laneCount >>= 1;
+        dpTxLtData.stateCb = configureLinkHandler;
+    } else if (dpTxLtData.result.linkRate > DP_TX_LT_RATE_RBR) {
+        finishTraining(DP_TX_LT_STATUS_REDUCE_RATE);
+    } else {
+        finishTraining(status);
+    }
+}
+
+/**
+ * Handler for state finishing training, host is notified
+ */
+static void doneHandler(void)
+{
+    uint8_t evCode = (dpTxLtData.result.status == DP_TX_LT_STATUS_SUCCESS)
+                   ? (uint8_t)DP_TX_EVENT_CODE_TRAINING_DONE
+                   : (uint8_t)DP_TX_EVENT_CODE_TRAINING_FAILED;
+
+    dpTxLtData.result.durationUs = getTimerUsWithoutUpdate(DP_TX_LINK_TRAINING_TIMER);
+    dpTxLtData.stateCb = NULL;
+
+    DP_TX_MAIL_HANDLER_notifyTrainingEv(evCode);
+}
+
+/**
+ * Handler for state checking status of channel equalization
+ */
+static void eqCheckHandler(void)
+{
+    dpTxLtData.loops++;
+    dpTxLtData.result.eqLoops++;
+
+    if (isLaneStatusSet(DP_TX_LT_LANE_CR_DONE | DP_TX_LT_LANE_EQ_DONE | DP_TX_LT_LANE_SYMBOL_LOCKED)
+            && ((dpTxLtData.result.laneStatus[DP_TX_LT_ALIGN_STATUS_OFFSET] & DP_TX_LT_INTERLANE_ALIGN_DONE) != 0U)) {
+        finishTraining(DP_TX_LT_STATUS_SUCCESS);
+    } else if (dpTxLtData.cacheEntry != NULL) {
+        /* Remembered settings don't work anymore, forget them and do full training */
+        dpTxLtData.cacheEntry->valid = false;
+        dpTxLtData.cacheEntry = NULL;
+        dpTxLtData.result.cached = false;
+        dpTxLtData.result.laneCount = dpTxLtData.maxLaneCount;
+        dpTxLtData.stateCb = configureLinkHandler;
+    } else if (!isLaneStatusSet(DP_TX_LT_LANE_CR_DONE)) {
+        /* Clock recovery lost */
+        fallback(DP_TX_LT_STATUS_CR_FAILED);
+    } else if (dpTxLtData.loops >= DP_TX_LT_MAX_EQ_LOOPS) {
+        fallback(DP_TX_LT_STATUS_EQ_FAILED);
+    } else {
+        (void)adjustDrive();
+        setLaneSetRequest(eqWaitHandler);
+    }
+}
+
+/**
+ * Handler for state reading status of channel equalization
+ */
+static void eqReadStatusHandler(void)
+{
+    setDpcdRequest(DP_REQUEST_READ, DPCD_LANE0_1_STATUS_ADDR, DP_TX_LT_LANE_STATUS_SIZE,
+                   dpTxLtData.result.laneStatus, eqCheckHandler);
+}
+
+/**
+ * Handler for state waiting for sink during channel equalization
+ */
+static void eqWaitHandler(void)
+{
+    modRunnerSleep(dpTxLtData.eqIntervalUs);
+    dpTxLtData.stateCb = eqReadStatusHandler;
+}
+
+/**
+ * Handler for state starting channel equalization phase
+ */
+static void startEqHandler(void)
+{
+    uint8_t pattern;
+
+    dpTxLtData.loops = 0U;
+
+    setSourcePattern(dpTxLtData.eqPattern);
+
+    if (dpTxLtData.eqPattern == DP_TX_LT_TPS4) {
+        pattern = DP_TX_LT_PATTERN_TPS4;
+    } else {
+        pattern = dpTxLtData.eqPattern | DP_TX_LT_SCRAMBLING_DISABLE;
+    }
+
+    setTrainingPatternRequest(pattern, eqWaitHandler);
+}
+
+/**
+ * Handler for state checking status of clock recovery
+ */
+static void crCheckHandler(void)
+{
+    dpTxLtData.loops++;
+    dpTxLtData.result.crLoops++;
+
+    if (isLaneStatusSet(DP_TX_LT_LANE_CR_DONE)) {
+        startEqHandler();
+    } else if (isMaxSwingReached()
+            || (dpTxLtData.sameSwingLoops >= DP_TX_LT_MAX_SAME_SWING)
+            || (dpTxLtData.loops >= DP_TX_LT_MAX_CR_LOOPS)) {
+        fallback(DP_TX_LT_STATUS_CR_FAILED);
+    } else {
+        if (adjustDrive()) {
+            dpTxLtData.sameSwingLoops = 0U;
+        } else {
+            dpTxLtData.sameSwingLoops++;
+        }
+
+        setLaneSetRequest(crWaitHandler);
+    }
+}
+
+/**
+ * Handler for state reading status of clock recovery
+ */
+static void crReadStatusHandler(void)
+{
+    setDpcdRequest(DP_REQUEST_READ, DPCD_LANE0_1_STATUS_ADDR, DP_TX_LT_LANE_STATUS_SIZE,
+                   dpTxLtData.result.laneStatus, crCheckHandler);
+}
+
+/**
+ * Handler for state waiting for sink during clock recovery
+ */
+static void crWaitHandler(void)
+{
+    modRunnerSleep(DP_TX_LT_CR_INTERVAL_US);
+    dpTxLtData.stateCb = crReadStatusHandler;
+}
+
+/**
+ * Handler for state starting clock recovery phase
+ */
+static void startCrHandler(void)
+{
+    dpTxLtData.loops = 0U;
+    dpTxLtData.sameSwingLoops = 0U;
+
+    setSourcePattern(DP_TX_LT_TPS1);
+    setTrainingPatternRequest(DP_TX_LT_TPS1 | DP_TX_LT_SCRAMBLING_DISABLE, crWaitHandler);
+}
+
+/**
+ * Handler for state configuring down-spread and channel coding
+ */
+static void configureCodingHandler(void)
+{
+    StateCallback_t nextState;
+
+    if (dpTxLtData.cacheEntry != NULL) {
+        /* Verify remembered drive levels by single equalization step */
+        nextState = startEqHandler;
+    } else {
+        nextState = startCrHandler;
+    }
+
+    /* DOWNSPREAD_CTRL (107h) and MAIN_LINK_CHANNEL_CODING_SET (108h) */
+    dpTxLtData.buffer[0] = dpTxLtData.downspread ? DP_TX_LT_SPREAD_AMP : 0U;
+    dpTxLtData.buffer[1] = DP_TX_LT_CODING_8B10B;
+
+    setDpcdRequest(DP_REQUEST_WRITE, DPCD_DOWNSPREAD_CTRL_ADDR, 2U, dpTxLtData.buffer, nextState);
+}
+
+/**
+ * Handler for state configuring link rate and number of lanes
+ */
+static void configureLinkHandler(void)
+{
+    if (dpTxLtData.cacheEntry != NULL) {
+        /* Start from remembered drive levels */
+        (void)memcpy(dpTxLtData.result.laneSet, dpTxLtData.cacheEntry->laneSet, sizeof(dpTxLtData.result.laneSet));
+    } else {
+        /* Start from the lowest drive levels */
+        (void)memset(dpTxLtData.result.laneSet, 0, sizeof(dpTxLtData.result.laneSet));
+    }
+
+    setSourceDrive();
+    setSourceLanes();
+
+    dpTxLtData.buffer[0] = dpTxLtData.result.linkRate;
+    dpTxLtData.buffer[1] = dpTxLtData.result.laneCount;
+    if (dpTxLtData.enhancedFraming) {
+        dpTxLtData.buffer[1] |= DP_TX_LT_ENHANCED_FRAME_EN;
+    }
+
+    setDpcdRequest(DP_REQUEST_WRITE, DPCD_LINK_BW_SET_ADDR, 2U, dpTxLtData.buffer, configureCodingHandler);
+}
+
+/**
+ * Handler for state reading sink identification
+ */
+static void readSinkIdHandler(void)
+{
+    setDpcdRequest(DP_REQUEST_READ, DPCD_SINK_IEEE_OUI_ADDR, DP_TX_LT_SINK_ID_SIZE,
+                   dpTxLtData.sinkId, capsHandler);
+    dpTxLtData.requestCb = sinkIdCb;
+}
+
+/**
+ * Handler for state processing receiver capability
+ */
+static void capsHandler(void)
+{
+    const uint8_t* caps = dpTxLtData.buffer;
+    uint8_t sinkLanes = caps[DP_TX_LT_CAPS_MAX_LANE_COUNT] & DP_TX_LT_MAX_LANE_COUNT_MASK;
+    uint8_t interval = caps[DP_TX_LT_CAPS_AUX_RD_INTERVAL] & DP_TX_LT_AUX_RD_INTERVAL_MASK;
+
+    dpTxLtData.result.laneCount = get_minimum(dpTxLtData.params.laneCount, sinkLanes);
+    dpTxLtData.enhancedFraming = dpTxLtData.params.enhancedFraming
+            && ((caps[DP_TX_LT_CAPS_MAX_LANE_COUNT] & DP_TX_LT_ENHANCED_FRAME_MASK) != 0U);
+    dpTxLtData.downspread = (caps[DP_TX_LT_CAPS_MAX_DOWNSPREAD] & DP_TX_LT_MAX_DOWNSPREAD_MASK) != 0U;
+
+    /* Use the best pattern supported by both sides */
+    if (dpTxLtData.params.tps4Supported
+            && ((caps[DP_TX_LT_CAPS_MAX_DOWNSPREAD] & DP_TX_LT_TPS4_SUPPORTED_MASK) != 0U)) {
+        dpTxLtData.eqPattern = DP_TX_LT_TPS4;
+    } else if (dpTxLtData.params.tps3Supported
+            && ((caps[DP_TX_LT_CAPS_MAX_LANE_COUNT] & DP_TX_LT_TPS3_SUPPORTED_MASK) != 0U)) {
+        dpTxLtData.eqPattern = DP_TX_LT_TPS3;
+    } else {
+        dpTxLtData.eqPattern = DP_TX_LT_TPS2;
+    }
+
+    dpTxLtData.eqIntervalUs = (interval == 0U)
+            ? DP_TX_LT_EQ_INTERVAL_US
+            : ((uint32_t)interval * DP_TX_LT_AUX_RD_INTERVAL_UNIT_US);
+
+    /* Sink hash uses receiver capability, so has to be calculated before buffer is reused */
+    dpTxLtData.sinkHash = getSinkHash();
+
+    if (dpTxLtData.result.linkRate > caps[DP_TX_LT_CAPS_MAX_LINK_RATE]) {
+        /* Rate is not supported by sink */
+        abortTraining(DP_TX_LT_STATUS_REDUCE_RATE);
+    } else if (dpTxLtData.result.laneCount == 0U) {
+        abortTraining(DP_TX_LT_STATUS_ABORTED);
+    } else {
+        /* Lane count supported by both sides must be 1, 2 or 4 */
+        if (dpTxLtData.result.laneCount == 3U) {
+            dpTxLtData.result.laneCount = 2U;
+        }
+        dpTxLtData.maxLaneCount = dpTxLtData.result.laneCount;
+
+        dpTxLtData.cacheEntry = getUsableCacheEntry();
+        if (dpTxLtData.cacheEntry != NULL) {
+            dpTxLtData.result.laneCount = dpTxLtData.cacheEntry->laneCount;
+            dpTxLtData.result.cached = true;
+        }
+
+        dpTxLtData.stateCb = configureLinkHandler;
+    }
+}
+
+/**
+ * Check if parameters given by host are valid
+ * @param[in] params, parameters of training
+ * @return 'true' if valid or 'false' if not
+ */
+static bool areParamsValid(const DpTxLtParams_t* params)
+{
+    bool isLaneCountValid = (params->laneCount == 1U) || (params->laneCount == 2U) || (params->laneCount == 4U);
+
+    return isLaneCountValid
+        && (params->linkRate != 0U)
+        && (params->maxVoltageSwing <= DP_TX_LT_MAX_LEVEL)
+        && (params->maxPreEmphasis <= DP_TX_LT_MAX_LEVEL);
+}
+
+/**
+ * Main thread of DP_TX_LT module
+ */
+static void DP_TX_LT_thread(void)
+{
+    if (dpTxLtData.stateCb != NULL) {
+        (*dpTxLtData.stateCb)();
+    }
+}
+
+/**
+ * Function used to start DP_TX_LT module
+ */
+static void DP_TX_LT_start_module(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize DP_TX_LT module
+ */
+static void DP_TX_LT_init(void)
+{
+    (void)memset(&dpTxLtData.result, 0, sizeof(dpTxLtData.result));
+    dpTxLtData.result.status = DP_TX_LT_STATUS_ABORTED;
+    dpTxLtData.stateCb = NULL;
+}
+
+void DP_TX_LT_start(const DpTxLtParams_t* params)
+{
+    if (dpTxLtData.stateCb == NULL) {
+        startTimer(DP_TX_LINK_TRAINING_TIMER);
+
+        dpTxLtData.params = *params;
+        (void)memset(&dpTxLtData.result, 0, sizeof(dpTxLtData.result));
+        dpTxLtData.result.status = DP_TX_LT_STATUS_IN_PROGRESS;
+        dpTxLtData.result.linkRate = params->linkRate;
+        dpTxLtData.cacheEntry = NULL;
+        dpTxLtData.sinkIdValid = false;
+
+        if (areParamsValid(params)) {
+            setDpcdRequest(DP_REQUEST_READ, DPCD_RECEIVER_CAP_ADDR, DP_TX_LT_CAPS_SIZE,
+                           dpTxLtData.buffer, readSinkIdHandler);
+        } else {
+            abortTraining(DP_TX_LT_STATUS_ABORTED);
+        }
+    }
+}
+
+bool DP_TX_LT_isBusy(void)
+{
+    return dpTxLtData.stateCb != NULL;
+}
+
+const DpTxLtResult_t* DP_TX_LT_getResult(void)
+{
+    return &dpTxLtData.result;
+}
+
+void DP_TX_LT_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t dpTxLtModule;
+
+    /* Assign thread functions into pointers */
+    dpTxLtModule.initTask = &DP_TX_LT_init;
+    dpTxLtModule.startTask = &DP_TX_LT_start_module;
+    dpTxLtModule.thread = &DP_TX_LT_thread;
+
+    dpTxLtModule.moduleId = MODRUNNER_MODULE_DP_TX_LINK_TRAINING;
+
+    /* Set priority of module */
+    dpTxLtModule.pPriority = 0U;
+
+    /* Attach module to system */
+    modRunnerInsertModule(&dpTxLtModule);
+}
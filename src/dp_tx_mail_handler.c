@@ -15,6 +15,10 @@
 
 #include "dp_tx_mail_handler.h"
 #include "dp_tx.h"
+#include "dp_tx_link_training.h"
+#include "dp_tx_sequencer.h"
+#include "dp_tx_link_monitor.h"
+#include "dp_tx_snapshot.h"
 #include "utils.h"
 #include "general_handler.h"
 #include "timer.h"
@@ -23,6 +27,9 @@
 #include "mailBox.h"
 #include "apbChecker.h"
 #include "events.h"
+#include "hpd_events.h"
+
+#include <string.h>
 
 /* Size of the EDID block */
 #define EDID_LENGTH 128
@@ -37,6 +44,11 @@
 #define DP_TX_I2C_RESP_MSG_MIN_SIZE  3U
 #define DP_TX_I2C_REQ_MSG_MIN_SIZE   4U
 #define DP_TX_DPCD_MSG_MIN_SIZE      5U
+#define DP_TX_TRAINING_MSG_MIN_SIZE  5U
+#define DP_TX_POLL_MSG_MIN_SIZE      9U
+#define DP_TX_RMW_MSG_MIN_SIZE       5U
+#define DP_TX_MONITOR_MSG_MIN_SIZE   2U
+#define DP_TX_STREAM_MSG_MIN_SIZE    8U
 
 /* Address of DPCD registers (chapter 2.9.3.2 of DP specification) */
 #define DPCD_TRAINING_LANE0_SET_ADDR    0x00103U
@@ -58,6 +70,70 @@
 #define EDID_SEGMENT_SLAVE_ADDRESS 0x30U
 #define EDID_SLAVE_ADDRESS         0x50U
 
+/* Flag of DPTX_GET_AUX_STATS request, statistics are cleared after read */
+#define DP_TX_AUX_STATS_RESET_FLAG 0x01U
+
+/* Flags of DPTX_TRAINING_CONTROL request */
+#define DP_TX_TRAINING_ENHANCED_FLAG 0x01U
+#define DP_TX_TRAINING_TPS3_FLAG     0x02U
+#define DP_TX_TRAINING_TPS4_FLAG     0x04U
+#define DP_TX_TRAINING_NO_CACHE_FLAG 0x08U
+
+/* Size of single event in DPTX_READ_HPD_EVENTS response */
+#define DP_TX_HPD_EVENT_SIZE 5U
+/* Size of DPTX_READ_HPD_EVENTS response header */
+#define DP_TX_HPD_EVENTS_HEADER_SIZE 2U
+
+/* Size of DPTX_POLL_DPCD response */
+#define DP_TX_POLL_RESP_SIZE 11U
+
+/* Status of DPTX_POLL_DPCD request */
+#define DP_TX_POLL_STATUS_MATCH     0x00U
+#define DP_TX_POLL_STATUS_TIMEOUT   0x01U
+#define DP_TX_POLL_STATUS_AUX_ERROR 0x02U
+#define DP_TX_POLL_STATUS_INVALID   0x03U
+
+/* Size of DPTX_RMW_DPCD response */
+#define DP_TX_RMW_RESP_SIZE 6U
+
+/* Status of DPTX_RMW_DPCD request */
+#define DP_TX_RMW_STATUS_OK          0x00U
+#define DP_TX_RMW_STATUS_READ_ERROR  0x01U
+#define DP_TX_RMW_STATUS_WRITE_ERROR 0x02U
+#define DP_TX_RMW_STATUS_INVALID     0x03U
+
+/* Status of DPTX_SEQ_UPLOAD request */
+#define DP_TX_SEQ_UPLOAD_OK       0x00U
+#define DP_TX_SEQ_UPLOAD_REJECTED 0x01U
+
+/* Size of DPTX_SEQ_RUN response header, read data follow it */
+#define DP_TX_SEQ_RESP_HEADER_SIZE 8U
+
+/* Size of DPTX_READ_LINK_MONITOR response */
+#define DP_TX_MONITOR_RESP_SIZE 7U
+
+/* Size of DPTX_READ_IRQ_VECTORS response */
+#define DP_TX_IRQ_VECTORS_RESP_SIZE 3U
+
+/* Size of DPTX_READ_SINK_SNAPSHOT response header (state), snapshot follows it */
+#define DP_TX_SNAPSHOT_RESP_HEADER_SIZE 1U
+
+/* Size of DPTX_READ_STREAM response header (status, sequence number), read data follow it */
+#define DP_TX_STREAM_RESP_HEADER_SIZE 3U
+
+/* Type of DPTX_READ_STREAM request */
+#define DP_TX_STREAM_TYPE_DPCD 0x00U
+#define DP_TX_STREAM_TYPE_I2C  0x01U
+
+/* Status of DPTX_READ_STREAM response */
+#define DP_TX_STREAM_STATUS_CONTINUE 0x00U
+#define DP_TX_STREAM_STATUS_LAST     0x01U
+#define DP_TX_STREAM_STATUS_ERROR    0x02U
+#define DP_TX_STREAM_STATUS_INVALID  0x03U
+
+/* Size of DPCD address space */
+#define DPCD_ADDRESS_SPACE_SIZE 0x100000U
+
 /* Request codes (host->controller) received via mailbox*/
 typedef enum {
     DPTX_SET_POWER_MNG       = 0x00U,
@@ -67,16 +143,29 @@ typedef enum {
     DPTX_ENABLE_EVENT        = 0x05U,
     DPTX_WRITE_REGISTER      = 0x06U,
     DPTX_WRITE_FIELD         = 0x08U,
+    DPTX_TRAINING_CONTROL    = 0x09U,
     DPTX_READ_EVENT          = 0x0AU,
+    DPTX_READ_LINK_STAT      = 0x0BU,
     DPTX_GET_LAST_AUX_STATUS = 0x0EU,
     DPTX_HPD_STATE           = 0x11U,
     DPTX_LT_ADJUST           = 0x12U,
     DPTX_I2C_READ            = 0x15U,
     DPTX_I2C_WRITE           = 0x16U,
-    DPTX_GET_LAST_I2C_STATUS = 0x17U
+    DPTX_GET_LAST_I2C_STATUS = 0x17U,
+    DPTX_GET_AUX_STATS       = 0x18U,
+    DPTX_READ_HPD_EVENTS     = 0x19U,
+    DPTX_POLL_DPCD           = 0x1AU,
+    DPTX_RMW_DPCD            = 0x1BU,
+    DPTX_SEQ_UPLOAD          = 0x1CU,
+    DPTX_SEQ_RUN             = 0x1DU,
+    DPTX_LINK_MONITOR_CONTROL = 0x1EU,
+    DPTX_READ_LINK_MONITOR   = 0x1FU,
+    DPTX_READ_IRQ_VECTORS    = 0x20U,
+    DPTX_READ_SINK_SNAPSHOT  = 0x21U,
+    DPTX_READ_STREAM         = 0x22U
 } DpTxMailRequest_t;
 
-#define NUMBER_OF_REQ_OPCODES     14U
+#define NUMBER_OF_REQ_OPCODES     27U
 
 /* Response codes (controller->host) received via mailbox */
 typedef enum {
@@ -84,6 +173,7 @@ typedef enum {
     DPTX_DPCD_READ_RESP     =  0x03U,
     DPTX_DPCD_WRITE_RESP    =  0x04U,
     DPTX_READ_EVENT_RESP    =  0x0AU,
+    DPTX_READ_LINK_STAT_RESP =  0x0BU,
     DPTX_I2C_READ_RESP      =  0x15U,
     DPTX_I2C_WRITE_RESP     =  0x16U
 } DpTxResponse_t;
@@ -99,6 +189,38 @@ typedef struct {
     DpTxMailRequest_t opCode;
 } MsgAction_t;
 
+/* Data of DPTX_POLL_DPCD request */
+typedef struct {
+    /* DPCD address */
+    uint32_t address;
+    /* Mask applied to read value */
+    uint8_t mask;
+    /* Expected value after masking */
+    uint8_t expected;
+    /* Time between reads in microseconds */
+    uint16_t intervalUs;
+    /* Maximum time of polling in milliseconds */
+    uint16_t timeoutMs;
+    /* Number of done reads */
+    uint16_t reads;
+    /* Time from start of polling in microseconds */
+    uint32_t elapsedUs;
+} DpTxPollData_t;
+
+/* Data of DPTX_READ_STREAM request */
+typedef struct {
+    /* Request type, DP_REQUEST_TYPE_AUX or DP_REQUEST_TYPE_I2C */
+    uint8_t type;
+    /* DPCD address of next chunk or I2C slave address */
+    uint32_t address;
+    /* Number of bytes not read yet */
+    uint32_t remaining;
+    /* Sequence number of next response message */
+    uint16_t sequence;
+    /* Data of mailbox message reserved for current chunk */
+    uint8_t* message;
+} DpTxStreamData_t;
+
 /* Data of DP mail handler */
 typedef struct {
     /* Mail handler state function*/
@@ -132,12 +254,26 @@ typedef struct {
      * and responding. Value != 0 also means, that current DPCD write/read
      * is related to Link Training. */
     uint16_t wait_time;
+    /* Position of host in ring of HPD events, used by DPTX_READ_HPD_EVENTS */
+    HpdEventsCursor_t hostHpdCursor;
+    /* Parameters and state of DPTX_POLL_DPCD request */
+    DpTxPollData_t poll;
+    /* Mask of bits modified by DPTX_RMW_DPCD request */
+    uint8_t rmwMask;
+    /* Value of bits modified by DPTX_RMW_DPCD request */
+    uint8_t rmwValue;
+    /* DEVICE_SERVICE_IRQ_VECTOR bits serviced since last DPTX_READ_IRQ_VECTORS */
+    uint8_t deviceIrqVector;
+    /* LINK_SERVICE_IRQ_VECTOR_ESI0 bits serviced since last DPTX_READ_IRQ_VECTORS */
+    uint8_t linkIrqVector;
+    /* Number of IRQ_HPD serviced since last DPTX_READ_IRQ_VECTORS */
+    uint8_t irqCount;
+    /* Parameters and state of DPTX_READ_STREAM request */
+    DpTxStreamData_t stream;
 } DpTxMailHandlerData_t;
 
 static DpTxMailHandlerData_t dpTxMailHandlerData;
 
-uint8_t hpdState;
-
 /* Handler for IDLE state */
 static void idleHandler(void);
 
@@ -156,6 +292,15 @@ static void timeoutHandler(void);
 /* Handler for PROCESSING_RX state */
 static void rxProcessingHandler(void);
 
+/* Handler for POLL_WAIT state */
+static void pollWaitHandler(void);
+
+/* Handler for SEQ_WAIT state */
+static void seqWaitHandler(void);
+
+/* Handler for STREAM_RESERVE state */
+static void streamReserveHandler(void);
+
 /**
  * Return length of data for I2C-native-AUX request.
  * @param[in] message, pointer to message via mailbox
@@ -391,6 +536,159 @@ static void i2cWriteCb(const DpTxRequestData_t* reply)
     dpTxMailHandlerData.stateCb = sendMessageHandler;
 }
 
+/**
+ * Auxiliary function used to generate DPTX_POLL_DPCD response
+ * @param[in] status, status of polling
+ * @param[in] value, last read value
+ */
+static void setPollResp(uint8_t status, uint8_t value)
+{
+    const DpTxPollData_t* poll = &dpTxMailHandlerData.poll;
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+
+    buffer[0] = GetByte2(poll->address);
+    buffer[1] = GetByte1(poll->address);
+    buffer[2] = GetByte0(poll->address);
+    buffer[3] = status;
+    buffer[4] = value;
+    setBe16(poll->reads, &buffer[5]);
+    setBe32(poll->elapsedUs, &buffer[7]);
+
+    dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_POLL_RESP_SIZE;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_POLL_DPCD;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Callback for single read of DPTX_POLL_DPCD request
+ * @param[in] reply, pointer to request data struct
+ */
+static void pollDpcdCb(const DpTxRequestData_t* reply)
+{
+    DpTxPollData_t* poll = &dpTxMailHandlerData.poll;
+    uint8_t value = dpTxMailHandlerData.buffer[DP_TX_POLL_RESP_SIZE];
+
+    poll->reads++;
+    poll->elapsedUs += getTimerUsWithUpdate(DP_TX_POLL_TIMER);
+    dpTxMailHandlerData.latestAuxError = reply->command & (uint8_t)DP_AUX_REPLY_MASK;
+
+    if (reply->bytes_reply != reply->length) {
+        setPollResp(DP_TX_POLL_STATUS_AUX_ERROR, 0U);
+    } else if ((value & poll->mask) == poll->expected) {
+        setPollResp(DP_TX_POLL_STATUS_MATCH, value);
+    } else if (poll->elapsedUs >= milliToMicro(poll->timeoutMs)) {
+        setPollResp(DP_TX_POLL_STATUS_TIMEOUT, value);
+    } else {
+        /* Read again after interval */
+        dpTxMailHandlerData.stateCb = pollWaitHandler;
+    }
+}
+
+/**
+ * Callback for single chunk of DPTX_READ_STREAM request. Chunk was read
+ * directly into reserved mailbox message, so only header is filled.
+ * @param[in] reply, pointer to request data struct
+ */
+static void readStreamCb(const DpTxRequestData_t* reply)
+{
+    DpTxStreamData_t* stream = &dpTxMailHandlerData.stream;
+    uint8_t* message = stream->message;
+    uint8_t status;
+
+    dpTxMailHandlerData.latestAuxError = reply->command & (uint8_t)DP_REPLY_MASK;
+    dpTxMailHandlerData.latestI2cError = (reply->command >> (uint8_t)DP_REPLY_I2C_OFFSET) & (uint8_t)DP_REPLY_MASK;
+
+    if (reply->bytes_reply != reply->length) {
+        /* Stream is finished after first failed chunk */
+        status = DP_TX_STREAM_STATUS_ERROR;
+        stream->remaining = 0U;
+    } else {
+        stream->remaining -= reply->bytes_reply;
+        status = (stream->remaining == 0U) ? DP_TX_STREAM_STATUS_LAST : DP_TX_STREAM_STATUS_CONTINUE;
+    }
+
+    if (stream->type == (uint8_t)DP_REQUEST_TYPE_AUX) {
+        stream->address += reply->bytes_reply;
+    }
+
+    message[0] = status;
+    setBe16(stream->sequence, &message[1]);
+    stream->sequence++;
+
+    /* Message is sent while next chunk is read */
+    MB_QueueTxMsg(dpTxMailHandlerData.messageBus,
+                  (uint32_t)DP_TX_STREAM_RESP_HEADER_SIZE + reply->bytes_reply,
+                  (uint8_t)DPTX_READ_STREAM,
+                  MB_MODULE_ID_DP);
+
+    dpTxMailHandlerData.stateCb = (stream->remaining > 0U) ? streamReserveHandler : idleHandler;
+}
+
+/**
+ * Auxiliary function used to generate DPTX_RMW_DPCD response
+ * @param[in] address, DPCD address
+ * @param[in] status, status of request
+ */
+static void setRmwResp(uint32_t address, uint8_t status)
+{
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+
+    /* Old and new values are already in buffer[4-5] */
+    buffer[0] = GetByte2(address);
+    buffer[1] = GetByte1(address);
+    buffer[2] = GetByte0(address);
+    buffer[3] = status;
+
+    dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_RMW_RESP_SIZE;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_RMW_DPCD;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Callback for write of DPTX_RMW_DPCD request
+ * @param[in] reply, pointer to request data struct
+ */
+static void rmwWriteCb(const DpTxRequestData_t* reply)
+{
+    uint8_t status = (reply->bytes_reply == reply->length)
+                   ? (uint8_t)DP_TX_RMW_STATUS_OK
+                   : (uint8_t)DP_TX_RMW_STATUS_WRITE_ERROR;
+
+    dpTxMailHandlerData.latestAuxError = reply->command & (uint8_t)DP_AUX_REPLY_MASK;
+    setRmwResp(reply->address, status);
+}
+
+/**
+ * Callback for read of DPTX_RMW_DPCD request. Write is queued without returning
+ * to idle state and is submitted in the same modRunner pass, before other DP_TX
+ * clients, only because module is inserted directly after DP_TX
+ * (see general_handler_set_active_mode).
+ * @param[in] reply, pointer to request data struct
+ */
+static void rmwReadCb(const DpTxRequestData_t* reply)
+{
+    DpTxRequestData_t* request = &dpTxMailHandlerData.request;
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+    uint8_t mask = dpTxMailHandlerData.rmwMask;
+
+    dpTxMailHandlerData.latestAuxError = reply->command & (uint8_t)DP_AUX_REPLY_MASK;
+
+    if (reply->bytes_reply != reply->length) {
+        buffer[4] = 0U;
+        buffer[5] = 0U;
+        setRmwResp(reply->address, DP_TX_RMW_STATUS_READ_ERROR);
+    } else {
+        /* Old value was read into buffer[4], new one is written from buffer[5] */
+        buffer[5] = (buffer[4] & (uint8_t)~mask) | (dpTxMailHandlerData.rmwValue & mask);
+
+        request->command = (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_WRITE;
+        request->buffer = &buffer[5];
+
+        dpTxMailHandlerData.callback = rmwWriteCb;
+        dpTxMailHandlerData.stateCb = rxProcessingHandler;
+    }
+}
+
 /**
  * Callback for DPTX_GET_EDID request
  * @param[in] reply, pointer to request data struct
@@ -601,7 +899,7 @@ static void setI2cRequest(DpTxMailRequest_t opCode, uint16_t length, const uint8
 {
     bool isWrite = (opCode == DPTX_I2C_WRITE);
     DpTxRequestData_t* request;
-    uint8_t index;
+    uint16_t index;
 
      /* Verify request parameters. */
      if (!is_i2c_aux_request_valid(length, message, isWrite)) {
@@ -846,6 +1144,435 @@ static void getLastI2cStatusHandler(const MailboxData_t* mailboxData)
 }
 /* parasoft-end-suppress MISRA2012-RULE-2_7-4*/
 
+/**
+ * Auxiliary function used to put channel statistics into response buffer
+ * @param[out] buffer, pointer to response buffer
+ * @param[in] stats, pointer to statistics of AUX or I2C-over-AUX channel
+ * @return number of bytes put into buffer
+ */
+static uint32_t putChannelStats(uint8_t* buffer, const DpTxChannelStats_t* stats)
+{
+    uint32_t offset = 0U;
+    uint8_t i;
+
+    setBe32(stats->transactions, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->ackCount, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->nackCount, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->deferCount, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->invalidCount, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->timeoutCount, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->retryCount, &buffer[offset]);
+    offset += 4U;
+    setBe32(stats->bytes, &buffer[offset]);
+    offset += 4U;
+
+    for (i = 0U; i < (uint8_t)DP_TX_STATS_HIST_BUCKETS; i++) {
+        setBe32(stats->txDoneHist[i], &buffer[offset]);
+        offset += 4U;
+    }
+
+    for (i = 0U; i < (uint8_t)DP_TX_STATS_HIST_BUCKETS; i++) {
+        setBe32(stats->rxDoneHist[i], &buffer[offset]);
+        offset += 4U;
+    }
+
+    return offset;
+}
+
+/**
+ * Handler for DPTX_GET_AUX_STATS request
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void getAuxStatsHandler(const MailboxData_t* mailboxData)
+{
+    const DpTxStats_t* stats = DP_TX_getStats();
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+    uint32_t length = 1U;
+
+    buffer[0] = (uint8_t)DP_TX_STATS_HIST_BUCKETS;
+    length += putChannelStats(&buffer[length], &stats->aux);
+    length += putChannelStats(&buffer[length], &stats->i2c);
+
+    /* Optional flags byte, statistics are kept if not present */
+    if ((mailboxData->length > 0U) && ((mailboxData->message[0] & (uint8_t)DP_TX_AUX_STATS_RESET_FLAG) != 0U)) {
+        DP_TX_resetStats();
+    }
+
+    dpTxMailHandlerData.responseLength = length;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_GET_AUX_STATS;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Handler for DPTX_TRAINING_CONTROL request
+ * Request legend:
+ * | message[0] | message[1] | message[2] |  message[3]  |   message[4]    |
+ * |    rate    |   lanes    |   flags    | max V. swing | max pre-emphasis|
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void trainingControlHandler(const MailboxData_t* mailboxData)
+{
+    const uint8_t* message = mailboxData->message;
+    DpTxLtParams_t params = { 0U };
+
+    /* Invalid parameters are rejected by training, host is notified by event */
+    if ((dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR)
+            && (mailboxData->length >= (uint16_t)DP_TX_TRAINING_MSG_MIN_SIZE)) {
+        params.linkRate = message[0];
+        params.laneCount = message[1];
+        params.enhancedFraming = ((message[2] & (uint8_t)DP_TX_TRAINING_ENHANCED_FLAG) != 0U);
+        params.tps3Supported = ((message[2] & (uint8_t)DP_TX_TRAINING_TPS3_FLAG) != 0U);
+        params.tps4Supported = ((message[2] & (uint8_t)DP_TX_TRAINING_TPS4_FLAG) != 0U);
+        params.useCache = ((message[2] & (uint8_t)DP_TX_TRAINING_NO_CACHE_FLAG) == 0U);
+        params.maxVoltageSwing = message[3];
+        params.maxPreEmphasis = message[4];
+    }
+
+    DP_TX_LT_start(&params);
+}
+
+/* parasoft-begin-suppress MISRA2012-RULE-2_7-4, "Parameter 'mailboxData unused in function, DRV-4576" */
+
+/**
+ * Handler for DPTX_READ_LINK_STAT request
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void readLinkStatHandler(const MailboxData_t* mailboxData)
+{
+    const DpTxLtResult_t* result = DP_TX_LT_getResult();
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+    uint32_t length = 0U;
+
+    buffer[length] = (uint8_t)result->status;
+    length++;
+    buffer[length] = result->linkRate;
+    length++;
+    buffer[length] = result->laneCount;
+    length++;
+    (void)memcpy(&buffer[length], result->laneSet, DP_TX_LT_MAX_LANES);
+    length += DP_TX_LT_MAX_LANES;
+    (void)memcpy(&buffer[length], result->laneStatus, DP_TX_LT_LANE_STATUS_SIZE);
+    length += DP_TX_LT_LANE_STATUS_SIZE;
+    buffer[length] = result->crLoops;
+    length++;
+    buffer[length] = result->eqLoops;
+    length++;
+    setBe32(result->durationUs, &buffer[length]);
+    length += 4U;
+    buffer[length] = (uint8_t)bool_to_uint(result->cached);
+    length++;
+
+    dpTxMailHandlerData.responseLength = length;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_READ_LINK_STAT_RESP;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Handler for DPTX_READ_HPD_EVENTS request
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void readHpdEventsHandler(const MailboxData_t* mailboxData)
+{
+    HpdEventsCursor_t* cursor = &dpTxMailHandlerData.hostHpdCursor;
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+    uint32_t length = DP_TX_HPD_EVENTS_HEADER_SIZE;
+    uint8_t count = 0U;
+    HpdEvent_t event;
+
+    while ((count < (uint8_t)HPD_EVENTS_RING_SIZE) && HPD_EVENTS_pop(cursor, &event)) {
+        buffer[length] = (uint8_t)event.type;
+        setBe32(event.timestamp, &buffer[length + 1U]);
+        length += DP_TX_HPD_EVENT_SIZE;
+        count++;
+    }
+
+    buffer[0] = count;
+    /* Number of lost events is saturated */
+    buffer[1] = (cursor->lost > 0xFFU) ? 0xFFU : (uint8_t)cursor->lost;
+    cursor->lost = 0U;
+
+    dpTxMailHandlerData.responseLength = length;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_READ_HPD_EVENTS;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+/* parasoft-end-suppress MISRA2012-RULE-2_7-4*/
+
+/**
+ * Handler for state reading DPCD register polled due to DPTX_POLL_DPCD request
+ */
+static void pollReadHandler(void)
+{
+    DpTxRequestData_t* request = &dpTxMailHandlerData.request;
+
+    /* Read value is put after response data */
+    request->address = dpTxMailHandlerData.poll.address;
+    request->command = (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ;
+    request->length = 1U;
+    request->buffer = &dpTxMailHandlerData.buffer[DP_TX_POLL_RESP_SIZE];
+
+    dpTxMailHandlerData.callback = pollDpcdCb;
+    dpTxMailHandlerData.stateCb = rxProcessingHandler;
+}
+
+/**
+ * Handler for DPTX_POLL_DPCD request
+ * Request legend:
+ * | message[0-2] | message[3] | message[4] | message[5-6] | message[7-8] |
+ * |   address    |    mask    |  expected  | interval(us) | timeout(ms)  |
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void pollDpcdHandler(const MailboxData_t* mailboxData)
+{
+    const uint8_t* message = mailboxData->message;
+    DpTxPollData_t* poll = &dpTxMailHandlerData.poll;
+    bool isRegularBus = (dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR);
+
+    (void)memset(poll, 0, sizeof(DpTxPollData_t));
+    startTimer(DP_TX_POLL_TIMER);
+
+    if (isRegularBus && (mailboxData->length >= (uint16_t)DP_TX_POLL_MSG_MIN_SIZE)) {
+        poll->address = getBe24(message);
+        poll->mask = message[3];
+        poll->expected = message[4];
+        poll->intervalUs = getBe16(&message[5]);
+        poll->timeoutMs = getBe16(&message[7]);
+
+        pollReadHandler();
+    } else {
+        /* If SAPB is used - inform host about it */
+        dpTxMailHandlerData.latestAuxError = isRegularBus ?
+                (uint8_t)DP_REPLY_ACK : (uint8_t)DP_AUX_REPLY_BUS_ERROR;
+        setPollResp(DP_TX_POLL_STATUS_INVALID, 0U);
+    }
+}
+
+/**
+ * Handler for DPTX_RMW_DPCD request
+ * Request legend:
+ * | message[0-2] | message[3] | message[4] |
+ * |   address    |    mask    |   value    |
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void rmwDpcdHandler(const MailboxData_t* mailboxData)
+{
+    const uint8_t* message = mailboxData->message;
+    DpTxRequestData_t* request = &dpTxMailHandlerData.request;
+    bool isRegularBus = (dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR);
+
+    if (isRegularBus && (mailboxData->length >= (uint16_t)DP_TX_RMW_MSG_MIN_SIZE)) {
+        dpTxMailHandlerData.rmwMask = message[3];
+        dpTxMailHandlerData.rmwValue = message[4];
+
+        request->address = getBe24(message);
+        request->command = (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ;
+        request->length = 1U;
+        request->buffer = &dpTxMailHandlerData.buffer[4];
+
+        dpTxMailHandlerData.callback = rmwReadCb;
+        dpTxMailHandlerData.stateCb = rxProcessingHandler;
+    } else {
+        /* If SAPB is used - inform host about it */
+        dpTxMailHandlerData.latestAuxError = isRegularBus ?
+                (uint8_t)DP_REPLY_ACK : (uint8_t)DP_AUX_REPLY_BUS_ERROR;
+        dpTxMailHandlerData.buffer[4] = 0U;
+        dpTxMailHandlerData.buffer[5] = 0U;
+        setRmwResp(0U, DP_TX_RMW_STATUS_INVALID);
+    }
+}
+
+/**
+ * Handler for DPTX_SEQ_UPLOAD request, message is the whole sequence
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void seqUploadHandler(const MailboxData_t* mailboxData)
+{
+    bool isRegularBus = (dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR);
+
+    if (isRegularBus && DP_TX_SEQ_upload(mailboxData->message, mailboxData->length)) {
+        dpTxMailHandlerData.buffer[0] = DP_TX_SEQ_UPLOAD_OK;
+    } else {
+        dpTxMailHandlerData.buffer[0] = DP_TX_SEQ_UPLOAD_REJECTED;
+    }
+
+    /* If SAPB is used - inform host about it */
+    dpTxMailHandlerData.latestAuxError = isRegularBus ?
+            (uint8_t)DP_REPLY_ACK : (uint8_t)DP_AUX_REPLY_BUS_ERROR;
+
+    dpTxMailHandlerData.responseLength = 1U;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_SEQ_UPLOAD;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Handler for DPTX_SEQ_RUN request, response is sent after sequence is finished
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+/* parasoft-begin-suppress MISRA2012-RULE-2_7-4, "Parameter 'mailboxData unused in function, DRV-4576" */
+static void seqRunHandler(const MailboxData_t* mailboxData)
+{
+    if (dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR) {
+        DP_TX_SEQ_run();
+        dpTxMailHandlerData.stateCb = seqWaitHandler;
+    } else {
+        /* If SAPB is used - inform host about it */
+        dpTxMailHandlerData.latestAuxError = (uint8_t)DP_AUX_REPLY_BUS_ERROR;
+        (void)memset(dpTxMailHandlerData.buffer, 0, DP_TX_SEQ_RESP_HEADER_SIZE);
+        dpTxMailHandlerData.buffer[0] = (uint8_t)DP_TX_SEQ_STATUS_INVALID;
+        dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_SEQ_RESP_HEADER_SIZE;
+        dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_SEQ_RUN;
+        dpTxMailHandlerData.stateCb = sendMessageHandler;
+    }
+}
+/* parasoft-end-suppress MISRA2012-RULE-2_7-4*/
+
+/**
+ * Handler for DPTX_LINK_MONITOR_CONTROL request
+ * Request legend:
+ * |  message[0-1]  |
+ * | interval (ms)  |
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void linkMonitorControlHandler(const MailboxData_t* mailboxData)
+{
+    if ((dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR)
+            && (mailboxData->length >= (uint16_t)DP_TX_MONITOR_MSG_MIN_SIZE)) {
+        DP_TX_LM_setInterval(getBe16(mailboxData->message));
+    }
+}
+
+/* parasoft-begin-suppress MISRA2012-RULE-2_7-4, "Parameter 'mailboxData unused in function, DRV-4576" */
+
+/**
+ * Handler for DPTX_READ_LINK_MONITOR request
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void readLinkMonitorHandler(const MailboxData_t* mailboxData)
+{
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+
+    buffer[DP_TX_LT_LANE_STATUS_SIZE] = DP_TX_LM_getStatus(buffer);
+
+    dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_MONITOR_RESP_SIZE;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_READ_LINK_MONITOR;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Handler for DPTX_READ_IRQ_VECTORS request
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void readIrqVectorsHandler(const MailboxData_t* mailboxData)
+{
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+
+    buffer[0] = dpTxMailHandlerData.deviceIrqVector;
+    buffer[1] = dpTxMailHandlerData.linkIrqVector;
+    buffer[2] = dpTxMailHandlerData.irqCount;
+
+    /* Vectors are cleared after read */
+    dpTxMailHandlerData.deviceIrqVector = 0U;
+    dpTxMailHandlerData.linkIrqVector = 0U;
+    dpTxMailHandlerData.irqCount = 0U;
+
+    dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_IRQ_VECTORS_RESP_SIZE;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_READ_IRQ_VECTORS;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Handler for DPTX_READ_SINK_SNAPSHOT request
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void readSinkSnapshotHandler(const MailboxData_t* mailboxData)
+{
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+    DpTxSnapshotState_t state;
+    const uint8_t* snapshot = DP_TX_SNAPSHOT_get(&state);
+    uint32_t length = DP_TX_SNAPSHOT_RESP_HEADER_SIZE;
+
+    buffer[0] = (uint8_t)state;
+
+    /* Snapshot is sent only if it is complete */
+    if (state == DP_TX_SNAPSHOT_STATE_READY) {
+        (void)memcpy(&buffer[DP_TX_SNAPSHOT_RESP_HEADER_SIZE], snapshot, DP_TX_SNAPSHOT_SIZE);
+        length += DP_TX_SNAPSHOT_SIZE;
+    }
+
+    dpTxMailHandlerData.responseLength = length;
+    dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_READ_SINK_SNAPSHOT;
+    dpTxMailHandlerData.stateCb = sendMessageHandler;
+}
+
+/**
+ * Check parameters of DPTX_READ_STREAM request
+ * @param[in] type, type of request (DP_TX_STREAM_TYPE_DPCD or DP_TX_STREAM_TYPE_I2C)
+ * @param[in] address, DPCD address or I2C slave address
+ * @param[in] length, number of bytes to read
+ * @return 'true' if request is valid or 'false' if not
+ */
+static bool isStreamRequestValid(uint8_t type, uint32_t address, uint32_t length)
+{
+    bool valid;
+
+    if (type == DP_TX_STREAM_TYPE_DPCD) {
+        /* Whole region must be in DPCD address space */
+        valid = (address < DPCD_ADDRESS_SPACE_SIZE) && (length <= (DPCD_ADDRESS_SPACE_SIZE - address));
+    } else if (type == DP_TX_STREAM_TYPE_I2C) {
+        valid = (address <= DP_TX_I2C_ADDRESS_RANGE);
+    } else {
+        valid = false;
+    }
+
+    return valid && (length > 0U);
+}
+
+/**
+ * Handler for DPTX_READ_STREAM request
+ * Request legend:
+ * | message[0] | message[1-3] | message[4-7] |
+ * |    type    |   address    |    length    |
+ * @param[in] mailboxData, pointer to data received via mailbox
+ */
+static void readStreamHandler(const MailboxData_t* mailboxData)
+{
+    const uint8_t* message = mailboxData->message;
+    DpTxStreamData_t* stream = &dpTxMailHandlerData.stream;
+    bool isRegularBus = (dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR);
+    bool valid = isRegularBus && (mailboxData->length >= (uint16_t)DP_TX_STREAM_MSG_MIN_SIZE);
+
+    if (valid) {
+        stream->address = getBe24(&message[1]);
+        stream->remaining = getBe32(&message[4]);
+        valid = isStreamRequestValid(message[0], stream->address, stream->remaining);
+    }
+
+    if (valid) {
+        stream->type = (message[0] == DP_TX_STREAM_TYPE_DPCD)
+                     ? (uint8_t)DP_REQUEST_TYPE_AUX
+                     : (uint8_t)DP_REQUEST_TYPE_I2C;
+        stream->sequence = 0U;
+        dpTxMailHandlerData.stateCb = streamReserveHandler;
+    } else {
+        /* If SAPB is used - inform host about it */
+        dpTxMailHandlerData.latestAuxError = isRegularBus ?
+                (uint8_t)DP_REPLY_ACK : (uint8_t)DP_AUX_REPLY_BUS_ERROR;
+
+        dpTxMailHandlerData.buffer[0] = DP_TX_STREAM_STATUS_INVALID;
+        setBe16(0U, &dpTxMailHandlerData.buffer[1]);
+
+        dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_STREAM_RESP_HEADER_SIZE;
+        dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_READ_STREAM;
+        dpTxMailHandlerData.stateCb = sendMessageHandler;
+    }
+}
+/* parasoft-end-suppress MISRA2012-RULE-2_7-4*/
+
 /**
  * Handler for DPTX_LT_ADJUST request
  * @param[in] mailboxData, pointer to data received via mailbox
@@ -914,7 +1641,20 @@ static void mailboxExecutor(const MailboxData_t* mailboxData)
             {ltAdjustHandler, DPTX_LT_ADJUST},
             {i2cReadHandler, DPTX_I2C_READ},
             {i2cWriteHandler, DPTX_I2C_WRITE},
-            {getLastI2cStatusHandler, DPTX_GET_LAST_I2C_STATUS}
+            {getLastI2cStatusHandler, DPTX_GET_LAST_I2C_STATUS},
+            {getAuxStatsHandler, DPTX_GET_AUX_STATS},
+            {trainingControlHandler, DPTX_TRAINING_CONTROL},
+            {readLinkStatHandler, DPTX_READ_LINK_STAT},
+            {readHpdEventsHandler, DPTX_READ_HPD_EVENTS},
+            {pollDpcdHandler, DPTX_POLL_DPCD},
+            {rmwDpcdHandler, DPTX_RMW_DPCD},
+            {seqUploadHandler, DPTX_SEQ_UPLOAD},
+            {seqRunHandler, DPTX_SEQ_RUN},
+            {linkMonitorControlHandler, DPTX_LINK_MONITOR_CONTROL},
+            {readLinkMonitorHandler, DPTX_READ_LINK_MONITOR},
+            {readIrqVectorsHandler, DPTX_READ_IRQ_VECTORS},
+            {readSinkSnapshotHandler, DPTX_READ_SINK_SNAPSHOT},
+            {readStreamHandler, DPTX_READ_STREAM}
     };
 
     /* If invalid opCode was received, any action will be done */
@@ -951,24 +1691,29 @@ static void idleHandler(void)
 
 static void rxProcessingHandler(void)
 {
-    /* Check if DP_TX module is not busy */
-    if (DP_TX_isAvailable()) {
-        /* Add request to DP_TX module */
-        DP_TX_addRequest(&dpTxMailHandlerData.request, dpTxMailHandlerData.callback);
+    /* Add request to DP_TX module, if it is not busy */
+    switch (DP_TX_submitWhenFree(&dpTxMailHandlerData.request, dpTxMailHandlerData.callback,
+                                 0U, DP_TX_SUBMIT_NO_TIMEOUT)) {
+    case DP_TX_SUBMIT_STATUS_SUBMITTED:
         /* Start timer to catch timeout if will appear */
         startTimer(MAILBOX_LINK_LATENCY_TIMER);
         /* Save handler of next state */
         dpTxMailHandlerData.stateCb = timeoutHandler;
-    } else {
+        break;
+    case DP_TX_SUBMIT_STATUS_NO_SINK:
         /* Can't handle to command right now, return to callback with empty data */
         DP_TX_removeRequest(&dpTxMailHandlerData.request, dpTxMailHandlerData.callback);
+        break;
+    default:
+        /* DP_TX is used by other module (e.g. link training or monitor), wait for next request slot */
+        break;
     }
 }
 
 static void sendMessageHandler(void)
 {
     uint8_t* responseBuff;
-    uint8_t i;
+    uint32_t i;
 
     MB_TYPE busType = dpTxMailHandlerData.messageBus;
 
@@ -1002,6 +1747,58 @@ static void linkTrainingWaitHandler(void)
     dpTxMailHandlerData.stateCb = readLinkTrainingResultHandler;
 }
 
+static void pollWaitHandler(void)
+{
+    /* Put module to sleep */
+    modRunnerSleep(dpTxMailHandlerData.poll.intervalUs);
+    /* Save handler of next state */
+    dpTxMailHandlerData.stateCb = pollReadHandler;
+}
+
+static void seqWaitHandler(void)
+{
+    const DpTxSeqResult_t* result;
+    uint8_t* buffer = dpTxMailHandlerData.buffer;
+
+    /* Sequence uses DP_TX module on its own, wait for its end */
+    if (!DP_TX_SEQ_isBusy()) {
+        result = DP_TX_SEQ_getResult();
+
+        buffer[0] = (uint8_t)result->status;
+        setBe16(result->pc, &buffer[1]);
+        setBe32(result->acc, &buffer[3]);
+        buffer[7] = result->length;
+        (void)memcpy(&buffer[DP_TX_SEQ_RESP_HEADER_SIZE], result->data, result->length);
+
+        dpTxMailHandlerData.responseLength = (uint32_t)DP_TX_SEQ_RESP_HEADER_SIZE + result->length;
+        dpTxMailHandlerData.responseOpcode = (uint8_t)DPTX_SEQ_RUN;
+        dpTxMailHandlerData.stateCb = sendMessageHandler;
+    }
+}
+
+static void streamReserveHandler(void)
+{
+    DpTxStreamData_t* stream = &dpTxMailHandlerData.stream;
+    DpTxRequestData_t* request = &dpTxMailHandlerData.request;
+
+    /* Chunk is read directly into message queued after previous ones,
+       wait if they still occupy whole mailbox buffer */
+    stream->message = MB_ReserveTxMsg(dpTxMailHandlerData.messageBus,
+                                      (uint32_t)DP_TX_STREAM_RESP_HEADER_SIZE + (uint32_t)DP_MAX_DATA_LEN);
+
+    if (stream->message != NULL) {
+        request->command = stream->type | (uint8_t)DP_REQUEST_READ;
+        request->address = stream->address;
+        request->length = (stream->remaining > (uint32_t)DP_MAX_DATA_LEN) ? (uint32_t)DP_MAX_DATA_LEN : stream->remaining;
+        request->buffer = &stream->message[DP_TX_STREAM_RESP_HEADER_SIZE];
+        /* I2C transaction is kept open between chunks */
+        request->endTransaction = (request->length == stream->remaining);
+
+        dpTxMailHandlerData.callback = readStreamCb;
+        dpTxMailHandlerData.stateCb = rxProcessingHandler;
+    }
+}
+
 static void readLinkTrainingResultHandler(void)
 {
     bool isRegularBus = (dpTxMailHandlerData.messageBus == MB_TYPE_REGULAR);
@@ -1038,6 +1835,7 @@ static void DP_TX_MAIL_HANDLER_init(void)
     dpTxMailHandlerData.wait_time = 0U;
     dpTxMailHandlerData.latestAuxError = 0U;
     dpTxMailHandlerData.latestI2cError = 0U;
+    HPD_EVENTS_initCursor(&dpTxMailHandlerData.hostHpdCursor);
 }
 
 /**
@@ -1050,11 +1848,6 @@ static void DP_TX_MAIL_HANDLER_start(void)
 
 void DP_TX_MAIL_HANDLER_notifyHpdEv(uint8_t eventCode)
 {
-    uint32_t regVal;
-
-    /* Update global register */
-    hpdState |= eventCode;
-
     if ((dpTxMailHandlerData.enabledEvFlags & (uint8_t)DP_TX_EVENT_CODE_HPD_HIGH) != 0U) {
         /* Update host events */
         dpTxMailHandlerData.eventDetails = eventCode;
@@ -1062,6 +1855,45 @@ void DP_TX_MAIL_HANDLER_notifyHpdEv(uint8_t eventCode)
     }
 }
 
+void DP_TX_MAIL_HANDLER_notifyTrainingEv(uint8_t eventCode)
+{
+    if ((dpTxMailHandlerData.enabledEvFlags & eventCode) != 0U) {
+        /* Update host events */
+        dpTxMailHandlerData.eventDetails |= eventCode;
+        RegWrite(XT_EVENTS0, (uint8_t)EVENT_ID_DPTX_TRAINING);
+    }
+}
+
+void DP_TX_MAIL_HANDLER_notifyLinkStatusEv(void)
+{
+    if ((dpTxMailHandlerData.enabledEvFlags & (uint8_t)DP_TX_EVENT_CODE_LINK_STATUS) != 0U) {
+        /* Update host events */
+        dpTxMailHandlerData.eventDetails |= (uint8_t)DP_TX_EVENT_CODE_LINK_STATUS;
+        RegWrite(XT_EVENTS0, (uint8_t)EVENT_ID_DPTX_LINK_STATUS);
+    }
+}
+
+void DP_TX_MAIL_HANDLER_notifySnapshotEv(void)
+{
+    if ((dpTxMailHandlerData.enabledEvFlags & (uint8_t)DP_TX_EVENT_CODE_SINK_SNAPSHOT) != 0U) {
+        /* Update host events */
+        dpTxMailHandlerData.eventDetails |= (uint8_t)DP_TX_EVENT_CODE_SINK_SNAPSHOT;
+        RegWrite(XT_EVENTS0, (uint8_t)EVENT_ID_DPTX_SINK_SNAPSHOT);
+    }
+}
+
+void DP_TX_MAIL_HANDLER_notifyIrqEv(uint8_t deviceVector, uint8_t linkVector)
+{
+    dpTxMailHandlerData.deviceIrqVector |= deviceVector;
+    dpTxMailHandlerData.linkIrqVector |= linkVector;
+    if (dpTxMailHandlerData.irqCount < 0xFFU) {
+        dpTxMailHandlerData.irqCount++;
+    }
+
+    DP_TX_MAIL_HANDLER_notifyHpdEv((uint8_t)DP_TX_EVENT_CODE_HPD_STATE_HIGH
+                                 | (uint8_t)DP_TX_EVENT_CODE_HPD_PULSE);
+}
+
 void DP_TX_MAIL_HANDLER_initOnReset(void)
 {
     /* Set up all events */
@@ -0,0 +1,433 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_sequencer.c
+ *
+ ******************************************************************************
+ */
+
+#include "dp_tx_sequencer.h"
+#include "dp_tx.h"
+#include "timer.h"
+#include "utils.h"
+#include "cdn_stdtypes.h"
+
+#include <string.h>
+
+/* Number of instructions, opcodes are listed in dp_tx_sequencer.h */
+#define DP_TX_SEQ_NUMBER_OF_OPS 10U
+
+/* Maximum number of executed instructions, protects against endless loops */
+#define DP_TX_SEQ_MAX_STEPS 1024U
+
+/* Sequence is aborted if DP_TX module is not available in given time */
+#define DP_TX_SEQ_TIMEOUT_MS 1000U
+
+/* Range of I2C devices addresses */
+#define DP_TX_SEQ_I2C_ADDRESS_RANGE 127U
+
+/* Pointer to instruction handler, operands follow opcode in sequence */
+typedef void (*InstructionHandler_t)(const uint8_t* operands);
+
+/* Structure used to connect opcodes with handlers */
+typedef struct {
+    /* Pointer to instruction handler */
+    InstructionHandler_t handler;
+    /* Number of fixed operand bytes, data of write instructions are not included */
+    uint8_t operandsSize;
+} Instruction_t;
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* Saved sequence */
+    uint8_t program[DP_TX_SEQ_PROGRAM_SIZE];
+    /* Size of saved sequence in bytes */
+    uint16_t programLength;
+    /* Offset of instruction executed after current one */
+    uint16_t nextPc;
+    /* Number of executed instructions */
+    uint16_t steps;
+    /* First byte read by the latest read instruction */
+    uint8_t last;
+    /* Request for DP_TX module */
+    DpTxRequestData_t request;
+    /* Result of sequence */
+    DpTxSeqResult_t result;
+} DpTxSeqData_t;
+
+static DpTxSeqData_t dpTxSeqData;
+
+static void executeHandler(void);
+
+/**
+ * Finish sequence
+ * @param[in] status, status of sequence
+ */
+static void finishSequence(DpTxSeqStatus_t status)
+{
+    dpTxSeqData.result.status = status;
+    dpTxSeqData.stateCb = NULL;
+}
+
+/**
+ * Go to next instruction
+ */
+static void nextInstruction(void)
+{
+    dpTxSeqData.result.pc = dpTxSeqData.nextPc;
+    dpTxSeqData.stateCb = executeHandler;
+}
+
+/**
+ * Check if operands are inside of sequence
+ * @param[in] size, number of operand bytes following opcode
+ * @return 'true' if inside or 'false' if not
+ */
+static bool hasOperands(uint32_t size)
+{
+    return ((uint32_t)dpTxSeqData.result.pc + 1U + size) <= (uint32_t)dpTxSeqData.programLength;
+}
+
+/**
+ * Callback of DP_TX request
+ * @param[in] reply, finished request
+ */
+static void requestCb(const DpTxRequestData_t* reply)
+{
+    if (reply->bytes_reply != reply->length) {
+        /* AUX failure or unplug */
+        finishSequence(DP_TX_SEQ_STATUS_AUX_ERROR);
+    } else {
+        if ((reply->command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_READ) {
+            dpTxSeqData.last = reply->buffer[0];
+            dpTxSeqData.result.length += (uint8_t)reply->length;
+        }
+        nextInstruction();
+    }
+}
+
+/**
+ * Handler for state sending request to DP_TX module
+ */
+static void sendRequestHandler(void)
+{
+    switch (DP_TX_submitWhenFree(&dpTxSeqData.request, requestCb,
+                                 getTimerMsWithoutUpdate(DP_TX_SEQ_TIMER), DP_TX_SEQ_TIMEOUT_MS)) {
+    case DP_TX_SUBMIT_STATUS_SUBMITTED:
+        dpTxSeqData.stateCb = DP_TX_waitRequestHandler;
+        break;
+    case DP_TX_SUBMIT_STATUS_NO_SINK:
+        /* Same status as request failed due to unplug */
+        finishSequence(DP_TX_SEQ_STATUS_AUX_ERROR);
+        break;
+    case DP_TX_SUBMIT_STATUS_TIMEOUT:
+        finishSequence(DP_TX_SEQ_STATUS_TIMEOUT);
+        break;
+    default:
+        /* Wait for DP_TX module */
+        break;
+    }
+}
+
+/**
+ * Prepare request, which is sent in next state
+ * @param[in] command, type and direction of request
+ * @param[in] address, DPCD address or I2C slave address
+ * @param[in] length, number of bytes to read/write
+ * @param[in] mot, middle-of-transaction (I2C only)
+ */
+static void setRequest(uint8_t command, uint32_t address, uint8_t length, bool mot)
+{
+    DpTxRequestData_t* request = &dpTxSeqData.request;
+    bool isRead = ((command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_READ);
+    uint32_t dataLength = isRead ? 0U : (uint32_t)length;
+
+    if ((length == 0U) || (((uint32_t)dpTxSeqData.nextPc + dataLength) > dpTxSeqData.programLength)) {
+        /* Empty transfer or written data outside of sequence */
+        finishSequence(DP_TX_SEQ_STATUS_INVALID);
+    } else if (isRead && (((uint32_t)dpTxSeqData.result.length + length) > DP_TX_SEQ_RESULT_SIZE)) {
+        /* Result buffer is full */
+        finishSequence(DP_TX_SEQ_STATUS_INVALID);
+    } else {
+        request->command = command;
+        request->address = address;
+        request->length = length;
+        request->endTransaction = !mot;
+
+        if (isRead) {
+            /* Read data are appended to result */
+            request->buffer = &dpTxSeqData.result.data[dpTxSeqData.result.length];
+        } else {
+            /* Written data are taken directly from sequence */
+            request->buffer = &dpTxSeqData.program[dpTxSeqData.nextPc];
+            dpTxSeqData.nextPc += (uint16_t)length;
+        }
+
+        startTimer(DP_TX_SEQ_TIMER);
+        dpTxSeqData.stateCb = sendRequestHandler;
+    }
+}
+
+/**
+ * Handler of END instruction
+ * @param[in] operands, instruction operands
+ */
+/* parasoft-begin-suppress MISRA2012-RULE-2_7-4, "Parameter 'operands unused in function, DRV-4576" */
+static void endInstruction(const uint8_t* operands)
+{
+    finishSequence(DP_TX_SEQ_STATUS_SUCCESS);
+}
+/* parasoft-end-suppress MISRA2012-RULE-2_7-4*/
+
+/**
+ * Handler of AUX_READ instruction
+ * @param[in] operands, address[3], length[1]
+ */
+static void auxReadInstruction(const uint8_t* operands)
+{
+    setRequest((uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, getBe24(operands), operands[3], false);
+}
+
+/**
+ * Handler of AUX_WRITE instruction
+ * @param[in] operands, address[3], length[1], data[length]
+ */
+static void auxWriteInstruction(const uint8_t* operands)
+{
+    setRequest((uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_WRITE, getBe24(operands), operands[3], false);
+}
+
+/**
+ * Setup I2C-over-AUX request
+ * @param[in] requestCode, DP_REQUEST_READ or DP_REQUEST_WRITE
+ * @param[in] operands, address[1], length[1], mot[1]
+ */
+static void setI2cRequest(DpRequest_t requestCode, const uint8_t* operands)
+{
+    if ((operands[0] > (uint8_t)DP_TX_SEQ_I2C_ADDRESS_RANGE) || (operands[2] > 1U)) {
+        finishSequence(DP_TX_SEQ_STATUS_INVALID);
+    } else {
+        setRequest((uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)requestCode, operands[0], operands[1], (operands[2] != 0U));
+    }
+}
+
+/**
+ * Handler of I2C_READ instruction
+ * @param[in] operands, address[1], length[1], mot[1]
+ */
+static void i2cReadInstruction(const uint8_t* operands)
+{
+    setI2cRequest(DP_REQUEST_READ, operands);
+}
+
+/**
+ * Handler of I2C_WRITE instruction
+ * @param[in] operands, address[1], length[1], mot[1], data[length]
+ */
+static void i2cWriteInstruction(const uint8_t* operands)
+{
+    setI2cRequest(DP_REQUEST_WRITE, operands);
+}
+
+/**
+ * Handler of SLEEP instruction
+ * @param[in] operands, time in microseconds[2]
+ */
+static void sleepInstruction(const uint8_t* operands)
+{
+    modRunnerSleep(getBe16(operands));
+    nextInstruction();
+}
+
+/**
+ * Jump to instruction if condition is met
+ * @param[in] condition, result of comparison
+ * @param[in] offset, signed offset relative to the next instruction
+ */
+static void branch(bool condition, uint8_t offset)
+{
+    int32_t target = (int32_t)dpTxSeqData.nextPc + (int32_t)((int8_t)offset);
+
+    if (!condition) {
+        nextInstruction();
+    } else if ((target < 0) || (target >= (int32_t)dpTxSeqData.programLength)) {
+        finishSequence(DP_TX_SEQ_STATUS_INVALID);
+    } else {
+        dpTxSeqData.nextPc = (uint16_t)target;
+        nextInstruction();
+    }
+}
+
+/**
+ * Handler of BRANCH_EQ instruction
+ * @param[in] operands, mask[1], value[1], offset[1]
+ */
+static void branchEqInstruction(const uint8_t* operands)
+{
+    branch((dpTxSeqData.last & operands[0]) == operands[1], operands[2]);
+}
+
+/**
+ * Handler of BRANCH_NE instruction
+ * @param[in] operands, mask[1], value[1], offset[1]
+ */
+static void branchNeInstruction(const uint8_t* operands)
+{
+    branch((dpTxSeqData.last & operands[0]) != operands[1], operands[2]);
+}
+
+/**
+ * Handler of ACC_ADD instruction
+ * @param[in] operands, mask[1]
+ */
+static void accAddInstruction(const uint8_t* operands)
+{
+    dpTxSeqData.result.acc += (uint32_t)dpTxSeqData.last & operands[0];
+    nextInstruction();
+}
+
+/**
+ * Handler of ACC_OR instruction
+ * @param[in] operands, mask[1]
+ */
+static void accOrInstruction(const uint8_t* operands)
+{
+    dpTxSeqData.result.acc |= (uint32_t)dpTxSeqData.last & operands[0];
+    nextInstruction();
+}
+
+/**
+ * Handler for state decoding and executing single instruction
+ */
+static void executeHandler(void)
+{
+    /* Array with instruction handlers, indexed by opcode */
+    static const Instruction_t instructions[DP_TX_SEQ_NUMBER_OF_OPS] = {
+            {endInstruction, 0U},
+            {auxReadInstruction, 4U},
+            {auxWriteInstruction, 4U},
+            {i2cReadInstruction, 3U},
+            {i2cWriteInstruction, 3U},
+            {sleepInstruction, 2U},
+            {branchEqInstruction, 3U},
+            {branchNeInstruction, 3U},
+            {accAddInstruction, 1U},
+            {accOrInstruction, 1U}
+    };
+
+    uint16_t pc = dpTxSeqData.result.pc;
+    const Instruction_t* instruction;
+    uint8_t opcode;
+
+    if (dpTxSeqData.steps >= DP_TX_SEQ_MAX_STEPS) {
+        finishSequence(DP_TX_SEQ_STATUS_STEP_LIMIT);
+    } else if (pc >= dpTxSeqData.programLength) {
+        /* End of sequence reached without END instruction */
+        finishSequence(DP_TX_SEQ_STATUS_INVALID);
+    } else {
+        opcode = dpTxSeqData.program[pc];
+
+        if (opcode >= DP_TX_SEQ_NUMBER_OF_OPS) {
+            finishSequence(DP_TX_SEQ_STATUS_INVALID);
+        } else {
+            instruction = &instructions[opcode];
+
+            if (!hasOperands(instruction->operandsSize)) {
+                finishSequence(DP_TX_SEQ_STATUS_INVALID);
+            } else {
+                dpTxSeqData.steps++;
+                dpTxSeqData.nextPc = pc + 1U + (uint16_t)instruction->operandsSize;
+                (instruction->handler)(&dpTxSeqData.program[pc + 1U]);
+            }
+        }
+    }
+}
+
+/**
+ * Main thread of DP_TX_SEQ module
+ */
+static void DP_TX_SEQ_thread(void)
+{
+    if (dpTxSeqData.stateCb != NULL) {
+        (*dpTxSeqData.stateCb)();
+    }
+}
+
+/**
+ * Function used to start DP_TX_SEQ module
+ */
+static void DP_TX_SEQ_start_module(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize DP_TX_SEQ module
+ */
+static void DP_TX_SEQ_init(void)
+{
+    (void)memset(&dpTxSeqData.result, 0, sizeof(dpTxSeqData.result));
+    dpTxSeqData.programLength = 0U;
+    dpTxSeqData.stateCb = NULL;
+}
+
+bool DP_TX_SEQ_upload(const uint8_t* program, uint16_t length)
+{
+    bool isSaved = false;
+
+    if ((dpTxSeqData.stateCb == NULL) && (length <= (uint16_t)DP_TX_SEQ_PROGRAM_SIZE)) {
+        (void)memcpy(dpTxSeqData.program, program, length);
+        dpTxSeqData.programLength = length;
+        isSaved = true;
+    }
+
+    return isSaved;
+}
+
+void DP_TX_SEQ_run(void)
+{
+    if (dpTxSeqData.stateCb == NULL) {
+        (void)memset(&dpTxSeqData.result, 0, sizeof(dpTxSeqData.result));
+        dpTxSeqData.steps = 0U;
+        dpTxSeqData.last = 0U;
+        dpTxSeqData.stateCb = executeHandler;
+    }
+}
+
+bool DP_TX_SEQ_isBusy(void)
+{
+    return dpTxSeqData.stateCb != NULL;
+}
+
+const DpTxSeqResult_t* DP_TX_SEQ_getResult(void)
+{
+    return &dpTxSeqData.result;
+}
+
+void DP_TX_SEQ_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t dpTxSeqModule;
+
+    /* Assign thread functions into pointers */
+    dpTxSeqModule.initTask = &DP_TX_SEQ_init;
+    dpTxSeqModule.startTask = &DP_TX_SEQ_start_module;
+    dpTxSeqModule.thread = &DP_TX_SEQ_thread;
+
+    dpTxSeqModule.moduleId = MODRUNNER_MODULE_DP_TX_SEQUENCER;
+
+    /* Set priority of module */
+    dpTxSeqModule.pPriority = 0U;
+
+    /* Attach module to system */
+    modRunnerInsertModule(&dpTxSeqModule);
+}
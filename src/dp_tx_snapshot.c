@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * dp_tx_snapshot.c
+ *
+ ******************************************************************************
+ */
+
+#include "dp_tx_snapshot.h"
+#include "dp_tx.h"
+#include "dp_tx_mail_handler.h"
+#include "utils.h"
+#include "cdn_stdtypes.h"
+
+#include <string.h>
+
+/* Address of DPCD registers */
+#define DPCD_RECEIVER_CAP_ADDR  0x00000U
+#define DPCD_MSTM_CAP_ADDR      0x00021U
+#define DPCD_HDCP2_RX_CAPS_ADDR 0x6921DU
+#define DPCD_HDCP1_BCAPS_ADDR   0x68028U
+
+/* EDID address on I2C bus (without direction bit) */
+#define EDID_SLAVE_ADDRESS 0x50U
+
+/* Offsets of fields in blob */
+#define DP_TX_SNAPSHOT_VERSION_OFFSET 0U
+#define DP_TX_SNAPSHOT_VALID_OFFSET   1U
+#define DP_TX_SNAPSHOT_CAPS_OFFSET    2U
+#define DP_TX_SNAPSHOT_MSTM_OFFSET    18U
+#define DP_TX_SNAPSHOT_RXCAPS_OFFSET  19U
+#define DP_TX_SNAPSHOT_BCAPS_OFFSET   22U
+#define DP_TX_SNAPSHOT_EDID_OFFSET    23U
+
+/* Number of reads done for snapshot */
+#define DP_TX_SNAPSHOT_READS_NUM 6U
+
+/* Single transaction done for snapshot */
+typedef struct {
+    /* Command of DP_TX request */
+    uint8_t command;
+    /* DPCD address or I2C slave address */
+    uint32_t address;
+    /* Number of bytes */
+    uint8_t length;
+    /* Offset in blob, used also as source of written data */
+    uint8_t offset;
+    /* Bit set in mask of valid fields if read succeeded, 0 for auxiliary transactions */
+    uint8_t validBit;
+    /* I2C transaction is finished with this request */
+    bool endTransaction;
+} SnapshotRead_t;
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* State of snapshot visible for host */
+    DpTxSnapshotState_t state;
+    /* Index of current transaction */
+    uint8_t step;
+    /* Snapshot blob */
+    uint8_t blob[DP_TX_SNAPSHOT_SIZE];
+    /* Request for DP_TX module */
+    DpTxRequestData_t request;
+} DpTxSnapshotData_t;
+
+static DpTxSnapshotData_t dpTxSnapshotData;
+
+/* Transactions done in order. EDID offset (0) is written from version field
+ * of blob, which is cleared until snapshot is ready. */
+static const SnapshotRead_t snapshotReads[DP_TX_SNAPSHOT_READS_NUM] = {
+        {(uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, DPCD_RECEIVER_CAP_ADDR, 16U,
+         DP_TX_SNAPSHOT_CAPS_OFFSET, DP_TX_SNAPSHOT_VALID_CAPS, false},
+        {(uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, DPCD_MSTM_CAP_ADDR, 1U,
+         DP_TX_SNAPSHOT_MSTM_OFFSET, DP_TX_SNAPSHOT_VALID_MSTM, false},
+        {(uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, DPCD_HDCP2_RX_CAPS_ADDR, 3U,
+         DP_TX_SNAPSHOT_RXCAPS_OFFSET, DP_TX_SNAPSHOT_VALID_RXCAPS, false},
+        {(uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, DPCD_HDCP1_BCAPS_ADDR, 1U,
+         DP_TX_SNAPSHOT_BCAPS_OFFSET, DP_TX_SNAPSHOT_VALID_BCAPS, false},
+        {(uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)DP_REQUEST_WRITE, EDID_SLAVE_ADDRESS, 1U,
+         DP_TX_SNAPSHOT_VERSION_OFFSET, 0U, false},
+        {(uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)DP_REQUEST_READ, EDID_SLAVE_ADDRESS, 128U,
+         DP_TX_SNAPSHOT_EDID_OFFSET, DP_TX_SNAPSHOT_VALID_EDID, true}
+};
+
+static void sendRequestHandler(void);
+
+/**
+ * Callback of DP_TX request
+ * @param[in] reply, finished request
+ */
+static void requestCb(const DpTxRequestData_t* reply)
+{
+    uint8_t* blob = dpTxSnapshotData.blob;
+
+    /* Failed read is not critical, field is only marked as invalid */
+    if (reply->bytes_reply == reply->length) {
+        blob[DP_TX_SNAPSHOT_VALID_OFFSET] |= snapshotReads[dpTxSnapshotData.step].validBit;
+    }
+
+    dpTxSnapshotData.step++;
+
+    if (dpTxSnapshotData.step < DP_TX_SNAPSHOT_READS_NUM) {
+        dpTxSnapshotData.stateCb = sendRequestHandler;
+    } else {
+        blob[DP_TX_SNAPSHOT_VERSION_OFFSET] = DP_TX_SNAPSHOT_VERSION;
+        dpTxSnapshotData.state = DP_TX_SNAPSHOT_STATE_READY;
+        dpTxSnapshotData.stateCb = NULL;
+
+        DP_TX_MAIL_HANDLER_notifySnapshotEv();
+    }
+}
+
+/**
+ * Handler for state sending request to DP_TX module
+ */
+static void sendRequestHandler(void)
+{
+    const SnapshotRead_t* read = &snapshotReads[dpTxSnapshotData.step];
+    DpTxRequestData_t* request = &dpTxSnapshotData.request;
+
+    request->command = read->command;
+    request->address = read->address;
+    request->length = read->length;
+    request->buffer = &dpTxSnapshotData.blob[read->offset];
+    request->endTransaction = read->endTransaction;
+
+    switch (DP_TX_submitWhenFree(request, requestCb, 0U, DP_TX_SUBMIT_NO_TIMEOUT)) {
+    case DP_TX_SUBMIT_STATUS_SUBMITTED:
+        dpTxSnapshotData.stateCb = DP_TX_waitRequestHandler;
+        break;
+    case DP_TX_SUBMIT_STATUS_NO_SINK:
+        /* Sink was unplugged */
+        dpTxSnapshotData.state = DP_TX_SNAPSHOT_STATE_NO_SINK;
+        dpTxSnapshotData.stateCb = NULL;
+        break;
+    default:
+        /* Wait for DP_TX module */
+        break;
+    }
+}
+
+/**
+ * Main thread of DP_TX_SNAPSHOT module
+ */
+static void DP_TX_SNAPSHOT_thread(void)
+{
+    if (dpTxSnapshotData.stateCb != NULL) {
+        (*dpTxSnapshotData.stateCb)();
+    }
+}
+
+/**
+ * Function used to start DP_TX_SNAPSHOT module
+ */
+static void DP_TX_SNAPSHOT_start_module(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize DP_TX_SNAPSHOT module
+ */
+static void DP_TX_SNAPSHOT_init(void)
+{
+    dpTxSnapshotData.state = DP_TX_SNAPSHOT_STATE_NO_SINK;
+    dpTxSnapshotData.stateCb = NULL;
+}
+
+void DP_TX_SNAPSHOT_start(void)
+{
+    /* Re-plug during reading starts it from the beginning */
+    (void)memset(dpTxSnapshotData.blob, 0, sizeof(dpTxSnapshotData.blob));
+    dpTxSnapshotData.step = 0U;
+    dpTxSnapshotData.state = DP_TX_SNAPSHOT_STATE_IN_PROGRESS;
+    dpTxSnapshotData.stateCb = sendRequestHandler;
+}
+
+const uint8_t* DP_TX_SNAPSHOT_get(DpTxSnapshotState_t* state)
+{
+    /* Unplug is not reported to module, so check it there */
+    if ((dpTxSnapshotData.state == DP_TX_SNAPSHOT_STATE_READY) && !DP_TX_isPlugged()) {
+        dpTxSnapshotData.state = DP_TX_SNAPSHOT_STATE_NO_SINK;
+    }
+
+    *state = dpTxSnapshotData.state;
+
+    return dpTxSnapshotData.blob;
+}
+
+void DP_TX_SNAPSHOT_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t dpTxSnapshotModule;
+
+    /* Assign thread functions into pointers */
+    dpTxSnapshotModule.initTask = &DP_TX_SNAPSHOT_init;
+    dpTxSnapshotModule.startTask = &DP_TX_SNAPSHOT_start_module;
+    dpTxSnapshotModule.thread = &DP_TX_SNAPSHOT_thread;
+
+    dpTxSnapshotModule.moduleId = MODRUNNER_MODULE_DP_TX_SNAPSHOT;
+
+    /* Set priority of module */
+    dpTxSnapshotModule.pPriority = 0U;
+
+    /* Attach module to system */
+    modRunnerInsertModule(&dpTxSnapshotModule);
+}
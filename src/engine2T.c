@@ -43,11 +43,26 @@
 /* Look on: "HDCP mapping to DisplayPort", Rev 2.2, s2.5.2, p23 */
 #define HDCP2X_M_SHA256_SIZE 5U
 
+/* Number of limbs (32b words) in modulus of transmitter's public key */
+#define HDCP2X_PUB_KEY_MODULUS_N_LIMBS (HDCP2X_PUB_KEY_MODULUS_N_SIZE / 4U)
+/* Number of limbs (32b words) in exponent of transmitter's public key */
+#define HDCP2X_PUB_KEY_EXPONENT_E_LIMBS ((HDCP2X_PUB_KEY_EXPONENT_E_SIZE + 3U) / 4U)
+
 /* Structure used to store transmitter's public key
  * This is a single key, comprised in 2 parts */
 typedef struct {
     uint8_t modulusN[HDCP2X_PUB_KEY_MODULUS_N_SIZE];
     uint8_t exponentE[HDCP2X_PUB_KEY_EXPONENT_E_SIZE];
+    /* Limbs of modulus, used by Montgomery context */
+    uint32_t modulusLimbs[HDCP2X_PUB_KEY_MODULUS_N_LIMBS];
+    /* Limbs of R^2 mod N, calculated during first verification of signature */
+    uint32_t rrLimbs[HDCP2X_PUB_KEY_MODULUS_N_LIMBS];
+    /* Montgomery context of modulus, the same for all verified certificates */
+    IpiMontCtx_t montCtx;
+    /* Limbs of exponent */
+    uint32_t exponentLimbs[HDCP2X_PUB_KEY_EXPONENT_E_LIMBS];
+    /* Exponent in limb form, not converted for each verification */
+    Ipi_t exponentIpi;
 } Hdcp22PublicKey_t;
 
 typedef struct {
@@ -425,6 +440,15 @@ void ENG2T_SetKey(uint8_t const * const N, uint8_t const * const E)
 {
     CPS_BufferCopy(publicKeys.modulusN, N, (uint32_t)HDCP2X_PUB_KEY_MODULUS_N_SIZE);
     CPS_BufferCopy(publicKeys.exponentE, E, (uint32_t)HDCP2X_PUB_KEY_EXPONENT_E_SIZE);
+
+    /* Invalid modulus leaves context unusable, so verification of signature fails */
+    (void)ipi_mont_ctx_init(&publicKeys.montCtx, publicKeys.modulusLimbs, publicKeys.rrLimbs,
+                            (uint16_t)HDCP2X_PUB_KEY_MODULUS_N_LIMBS, N, HDCP2X_PUB_KEY_MODULUS_N_SIZE);
+
+    /* Exponent equal to 0 leaves empty Ipi, so verification of signature fails */
+    (void)ipi_rd_binary_static(&publicKeys.exponentIpi, publicKeys.exponentLimbs,
+                               (uint16_t)HDCP2X_PUB_KEY_EXPONENT_E_LIMBS, E, HDCP2X_PUB_KEY_EXPONENT_E_SIZE);
+
     trans2Data.useDebugRandomNumbers = false;
 }
 
@@ -530,6 +554,8 @@ uint32_t ENG2T_valid_cert_signature(void)
         set_pkcs_parameter(&pkcs_params_sig.output, key_from_signature, HDCP2X_PUB_KEY_MODULUS_N_SIZE);
         set_pkcs_parameter(&pkcs_params_sig.modulus_n, publicKeys.modulusN, HDCP2X_PUB_KEY_MODULUS_N_SIZE);
         set_pkcs_parameter(&pkcs_params_sig.exponent_e, publicKeys.exponentE, HDCP2X_PUB_KEY_EXPONENT_E_SIZE);
+        pkcs_params_sig.mont_ctx = &publicKeys.montCtx;
+        pkcs_params_sig.exponent_ipi = &publicKeys.exponentIpi;
     }
 
     retVal = pkcs1_v15_rsassa_verify(&pkcs_params_sig, shaOutput);
@@ -572,6 +598,9 @@ uint32_t ENG2T_set_AKE_No_Stored_km(uint8_t* const buffer)
         set_pkcs_parameter(&pkcs_params_km.output, AkeNoStored.ekpub_km, HDCP2X_EKPUB_KM_SIZE);
         set_pkcs_parameter(&pkcs_params_km.modulus_n, cert_rx->modulus_n, HDCP2X_CERTRX_MODULUS_N_SIZE);
         set_pkcs_parameter(&pkcs_params_km.exponent_e, cert_rx->exponent_e, HDCP2X_CERTRX_EXPONENT_E_SIZE);
+        /* Key of receiver is different for each receiver, no context is kept */
+        pkcs_params_km.mont_ctx = NULL;
+        pkcs_params_km.exponent_ipi = NULL;
     }
 
     retVal = pkcs1_rsaes_oaep_encrypt(&pkcs_params_km);
@@ -27,11 +27,19 @@
 #include "controlChannelM.h"
 #include "dp_tx_mail_handler.h"
 #include "dp_tx.h"
+#include "dp_tx_link_training.h"
+#include "dp_tx_sequencer.h"
+#include "dp_tx_link_monitor.h"
+#include "dp_tx_irq.h"
+#include "dp_tx_snapshot.h"
 #include "xtUtils.h"
 #include "utils.h"
 
 #include "apbChecker.h"
 #include "mode.h"
+#include "sink_model.h"
+#include "sink_bench.h"
+#include "crypto_bench.h"
 
 /* Pointer to request handlers */
 typedef void (*General_handler_req_handler_t)(uint8_t message[], uint16_t len, MB_TYPE type);
@@ -188,8 +196,22 @@ static void general_handler_set_active_mode(void) {
 #ifdef USE_TEST_MODULE
     TM_InsertModule();
 #endif // USE_TEST_MODULE
+#ifdef USE_SINK_MODEL
+    SINK_MODEL_InsertModule();
+    SINK_BENCH_InsertModule();
+#endif // USE_SINK_MODEL
+#ifdef USE_CRYPTO_BENCH
+    CRYPTO_BENCH_InsertModule();
+#endif // USE_CRYPTO_BENCH
     DP_TX_InsertModule();
+    /* Has to follow DP_TX directly: write of DPTX_RMW_DPCD is queued by read callback
+       and must be submitted before any other DP_TX client to keep read-modify-write atomic */
     DP_TX_MAIL_HANDLER_InsertModule();
+    DP_TX_LT_InsertModule();
+    DP_TX_SEQ_InsertModule();
+    DP_TX_LM_InsertModule();
+    DP_TX_IRQ_InsertModule();
+    DP_TX_SNAPSHOT_InsertModule();
 }
 
 /** Initialize general handler module */
@@ -19,7 +19,6 @@
 #include "controlChannelM.h"
 #include "cp_irq.h"
 #include "cps.h"
-#include "dp_tx_mail_handler.h"
 #include "engine1T.h"
 #include "engine2T.h"
 #include "general_handler.h"
@@ -143,16 +142,15 @@ static void sendCapabilityReqCb(void) {
  * @return 'true' if connection is lost (HPD_LOW), otherwise 'false'
  */
 static bool isHpdDown(void) {
-    bool isDown = ((hpdState & (uint8_t)DP_TX_EVENT_CODE_HPD_LOW) != 0U);
+    bool isDown = false;
+    HpdEvent_t event;
 
-    /* Handle HPD_PULSE interrupt */
-    if ((hpdState & (uint8_t)DP_TX_EVENT_CODE_HPD_PULSE) != 0U) {
-        hdcpGenData.hpdPulseIrq = true;
-        hpdState &= ~((uint8_t)DP_TX_EVENT_CODE_HPD_PULSE);
-    }
-
-    if (isDown) {
-        hpdState &= ~((uint8_t)DP_TX_EVENT_CODE_HPD_LOW);
+    while (HPD_EVENTS_pop(&hdcpGenData.hpdCursor, &event)) {
+        if (event.type == HPD_EVENT_UNPLUG) {
+            isDown = true;
+        } else {
+            /* Plug is handled by host, IRQ_HPD by DP_TX_IRQ module */
+        }
     }
 
     return isDown;
@@ -539,7 +537,7 @@ static void HDCP_TRAN_init(void) {
 
     hdcpGenData.stateCb = &waitForConfigCb;
     hdcpGenData.statusUpdate = false;
-    hdcpGenData.hpdPulseIrq = false;
+    hdcpGenData.cpIrq = false;
 
     /* No error and any info about status */
     hdcpGenData.status = 0U;
@@ -648,8 +646,13 @@ void HDCP_TRAN_sleep(uint32_t us, uint32_t us_fast) {
 }
 
 void HDCP_TRAN_initOnReset(void) {
-    /* Clean status of HPD */
-    hpdState = 0U;
+    /* Skip HPD events detected before */
+    HPD_EVENTS_initCursor(&hdcpGenData.hpdCursor);
+}
+
+void HDCP_TRAN_notifyCpIrq(void) {
+    /* Handled by CP_IRQ routine in HDCP thread */
+    hdcpGenData.cpIrq = true;
 }
 
 uint8_t *HDCP_TRAN_getBuffer(void) {
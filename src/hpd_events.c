@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * hpd_events.c
+ *
+ ******************************************************************************
+ */
+
+#include "hpd_events.h"
+#include "cdn_stdint.h"
+
+#include <xtensa/hal.h>
+
+/* Mask used to get index of event in the ring */
+#define HPD_EVENTS_INDEX_MASK (HPD_EVENTS_RING_SIZE - 1U)
+
+/* Maximum distance between writer and reader. Entry at distance equal
+ * to ring size may be just rewritten by interrupt, so it is not read. */
+#define HPD_EVENTS_MAX_PENDING (HPD_EVENTS_RING_SIZE - 1U)
+
+/* Events detected by interrupt service routine */
+static HpdEvent_t hpdEventsRing[HPD_EVENTS_RING_SIZE];
+
+/* Number of events put into the ring, modified only by interrupt */
+static volatile uint32_t hpdEventsHead = 0U;
+
+/* Keep compiler from moving ring accesses across accesses of head,
+ * ring itself is not volatile */
+static inline void compilerBarrier(void)
+{
+    __asm__ volatile ("" ::: "memory");
+}
+
+void HPD_EVENTS_push(HpdEventType_t type)
+{
+    HpdEvent_t* event = &hpdEventsRing[hpdEventsHead & HPD_EVENTS_INDEX_MASK];
+
+    event->timestamp = xthal_get_ccount();
+    event->type = type;
+
+    /* Publish event after it is written */
+    compilerBarrier();
+    hpdEventsHead = hpdEventsHead + 1U;
+}
+
+void HPD_EVENTS_initCursor(HpdEventsCursor_t* cursor)
+{
+    cursor->tail = hpdEventsHead;
+    cursor->lost = 0U;
+}
+
+bool HPD_EVENTS_pop(HpdEventsCursor_t* cursor, HpdEvent_t* event)
+{
+    bool isRead = false;
+    uint32_t head = hpdEventsHead;
+
+    while ((!isRead) && (cursor->tail != head)) {
+        if ((head - cursor->tail) > HPD_EVENTS_MAX_PENDING) {
+            /* Reader was too slow, skip overwritten events */
+            cursor->lost += (head - cursor->tail) - HPD_EVENTS_MAX_PENDING;
+            cursor->tail = head - HPD_EVENTS_MAX_PENDING;
+        }
+
+        *event = hpdEventsRing[cursor->tail & HPD_EVENTS_INDEX_MASK];
+        compilerBarrier();
+
+        /* Check if event was not overwritten by interrupt during copy */
+        head = hpdEventsHead;
+        if ((head - cursor->tail) > HPD_EVENTS_MAX_PENDING) {
+            cursor->lost++;
+        } else {
+            isRead = true;
+        }
+
+        cursor->tail++;
+    }
+
+    return isRead;
+}
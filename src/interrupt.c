@@ -19,6 +19,7 @@
 #include "general_handler.h"
 #include "reg.h"
 #include "dp_tx.h"
+#include "hpd_events.h"
 #include <xtensa/xtruntime.h>
 
 extern uint8_t g_hpd_state;
@@ -30,16 +31,18 @@ static void HpdEventDetectedIsr(void) {
     // Decode what kind of hpd event needs to be handled
     if (RegFieldRead(HPD_EVENT_DET, HPD_UNPLUGGED_DET_ACLK, hpd_event) != 0U) {
         g_hpd_state = 0;
+        HPD_EVENTS_push(HPD_EVENT_UNPLUG);
         DP_TX_disconnect();
     }
 
     if (RegFieldRead(HPD_EVENT_DET, HPD_RE_PLGED_DET_EVENT, hpd_event) != 0U) {
         g_hpd_state = 1U;
+        HPD_EVENTS_push(HPD_EVENT_PLUG);
         DP_TX_connect();
     }
 
     if (RegFieldRead(HPD_EVENT_DET, HPD_IRQ_DET_EVENT, hpd_event) != 0U) {
-        DP_TX_interrupt();
+        HPD_EVENTS_push(HPD_EVENT_IRQ);
     }
 }
 
@@ -62,11 +65,23 @@ static void interruptHandler(void *arg) {
         modRunnerWake(MODRUNNER_MODULE_DP_AUX_TX);
         DP_TX_setRxFlag();
     }
+    if (RegFieldRead(DP_AUX_INTERRUPT_SOURCE, AUX_MAIN_EXPIRE_TX, dp_aux_event) != 0U) {
+        // AUX reply timeout detected by controller
+        modRunnerWake(MODRUNNER_MODULE_DP_AUX_TX);
+        DP_TX_setTimeoutFlag();
+    }
 }
 
 // parasoft-end-suppress MISRA2012-RULE-8_13_a-4
 // parasoft-end-suppress MISRA2012-RULE-2_7
 
+#ifdef USE_SINK_MODEL
+/* see interrupt.h */
+void interruptRaise(void) {
+    interruptHandler(NULL);
+}
+#endif // USE_SINK_MODEL
+
 /** Initialize interrupts */
 void interruptInit(void) {
     // set up interrupt masks
@@ -74,7 +89,7 @@ void interruptInit(void) {
     RegWrite(INT_MASK_XT, 0xFFFFFFFCU);
     RegWrite(DPTX_INT_MASK, 0xFFFFFFFEU);
     RegWrite(HPD_EVENT_MASK, 0xFFFFFFF2U);
-    RegWrite(DP_AUX_INTERRUPT_MASK, 0xFFFFFFF5U);
+    RegWrite(DP_AUX_INTERRUPT_MASK, 0xFFFFFDF5U);
 
     (void) xtos_set_interrupt_handler(3U, &interruptHandler, NULL, NULL);
     (void) xtos_interrupt_enable(3U);
@@ -41,6 +41,7 @@
 #include <stdlib.h>
 #include "cdn_errno.h"
 #include "cdn_stdtypes.h"
+#include <xtensa/config/core.h>
 
 /* Number of Characters Per Limb */
 #define CHARS_PER_LIMB 4U
@@ -58,14 +59,36 @@
 
 #define MONTGOMERY_INIT_MASK 0x00000004U
 
+/* Sizes of modulus (in number of limbs) with specialized Montgomery kernels */
+#define MONT_KERNEL_1024_LIMBS 32U
+#define MONT_KERNEL_3072_LIMBS 96U
+
+/* Log2 of BITS_PER_LIMB */
+#define BITS_PER_LIMB_LOG2 5U
+
+/* Exponents up to this size are calculated without window (e.g. 65537) */
+#define SMALL_EXP_MAX_BITS BITS_PER_LIMB
+
+/* Number of (N->num_limbs + 1)-sized temporaries of exponentiation
+ * kept in arena: T (double size) and Z. Window table and A are sized separately. */
+#define EXP_MOD_ARENA_SLOTS 3U
+
+#if (IPI_EXP_MAX_WINDOW_SIZE < 1U) || (IPI_EXP_MAX_WINDOW_SIZE > 6U)
+#error "IPI_EXP_MAX_WINDOW_SIZE has to be in range 1-6!"
+#endif
+
+/* Number of odd powers kept for the largest window */
+#define EXP_MOD_TABLE_SIZE (1U << (IPI_EXP_MAX_WINDOW_SIZE - 1U))
+
 /** Pack of functions used as steps in exponential calculation process */
 static uint32_t exp_prereq_calc_r2_handler(void);
-static uint32_t exp_prereq_calc_mod_handler(void);
+static uint32_t exp_prereq_calc_r2_sqr_handler(void);
 static uint32_t exp_prereq_calc_x_dash_handler(void);
 static uint32_t exp_prereq_calc_a_handler(void);
 static uint32_t calculate_g(void);
 static uint32_t correct_exp_result(void);
 static uint32_t do_sliding_window_exp(void);
+static uint32_t do_small_exp(void);
 
 /** Pack of functions used as steps in dividing process */
 
@@ -96,8 +119,8 @@ typedef struct {
     Ipi_t* ipiPtr;
     /* Pointer to modulus ipi */
     const Ipi_t* N;
-    /* Ipi array used to calc helper window values */
-    Ipi_t W[64];
+    /* Odd powers of A in Montgomery form, W[i] = A^(2i+1) * R mod N */
+    Ipi_t W[EXP_MOD_TABLE_SIZE];
     /* Flag if input ipi is negative or not */
     bool isNeg;
     /* Initialization value of Montgomery multiplication */
@@ -106,6 +129,14 @@ typedef struct {
     uint8_t window_size;
     /* Iterator to go through exponent bits */
     Limb2BitIterator_t e_iterator;
+    /* Exponent, if small exponent path is used */
+    uint32_t e_small;
+    /* Number of exponent bits to process by small exponent path, 0 if not used */
+    uint8_t e_small_bits;
+    /* Precomputed Montgomery context, NULL if not used */
+    IpiMontCtx_t* ctx;
+    /* Number of Montgomery squarings left to get R^2 mod N */
+    uint8_t rr_squarings;
 } ExpModHelper_t;
 
 typedef struct {
@@ -131,8 +162,24 @@ typedef struct {
     bool is_initialized;
 } IpiDivHlp_t;
 
+/* Scoped bump arena for temporaries living during single exponentiation */
+typedef struct {
+    /* Memory chunk, NULL if arena is closed */
+    uint32_t* base;
+    /* Size of chunk in limbs */
+    uint16_t size;
+    /* Number of limbs already carved out */
+    uint16_t used;
+    /* Bytes of temporaries allocated out of arena, if it was too small */
+    uint32_t heapBytes;
+} IpiArena_t;
+
 static ExpModHelper_t expModHlp;
 static IpiDivHlp_t ipiDivHlp;
+static IpiArena_t ipiArena;
+
+/* Memory used by temporaries of the last exponentiation (in bytes) */
+static uint32_t expModPeakMem;
 
 /**
  * Used to clean up data in ipi buffer
@@ -377,6 +424,64 @@ static void ipi_init(Ipi_t* src_ipi)
     src_ipi->ptr = NULL;
 }
 
+/**
+ * Open arena for temporaries of single operation. All limbs are taken by
+ * single allocation, if it fails temporaries are allocated one by one.
+ * @param[in] nblimbs, size of arena in limbs
+ */
+static void ipi_arena_open(uint32_t nblimbs)
+{
+    ipiArena.base = NULL;
+    ipiArena.size = 0U;
+    ipiArena.used = 0U;
+    ipiArena.heapBytes = 0U;
+
+    if (nblimbs <= (UINT16_MAX / CHARS_PER_LIMB)) {
+        ipiArena.base = MEM_malloc((uint16_t)(nblimbs * CHARS_PER_LIMB));
+    }
+
+    if (ipiArena.base != NULL) {
+        ipiArena.size = (uint16_t)nblimbs;
+    }
+}
+
+/**
+ * Close arena, all limbs carved out of it are released at once
+ */
+static void ipi_arena_close(void)
+{
+    expModPeakMem = ((uint32_t)ipiArena.used * CHARS_PER_LIMB) + ipiArena.heapBytes;
+
+    if (ipiArena.base != NULL) {
+        MEM_free(ipiArena.base);
+    }
+
+    ipiArena.base = NULL;
+    ipiArena.size = 0U;
+    ipiArena.used = 0U;
+}
+
+/**
+ * Check if limbs were carved out of arena
+ * @param[in] ptr, pointer to limbs
+ * @return true if limbs belong to arena
+ */
+static inline bool is_in_arena(const uint32_t* ptr)
+{
+    return (ipiArena.base != NULL) && (ptr >= ipiArena.base) && (ptr < &ipiArena.base[ipiArena.size]);
+}
+
+/**
+ * Release limbs of Ipi. Limbs from arena are released when arena is closed.
+ * @param[in] ptr, pointer to limbs
+ */
+static inline void ipi_free_limbs(const uint32_t* ptr)
+{
+    if (!is_in_arena(ptr)) {
+        MEM_free(ptr);
+    }
+}
+
 /**
  * Unallocate one IPI
  * @param src_ipi, pointer to Ipi to unallocate.
@@ -386,7 +491,7 @@ void ipi_free( Ipi_t *src_ipi )
     if (src_ipi != NULL) {
 
         if( src_ipi->ptr != NULL ) {
-            MEM_free(src_ipi->ptr);
+            ipi_free_limbs(src_ipi->ptr);
         }
 
         ipi_init(src_ipi);
@@ -429,7 +534,7 @@ static uint32_t ipi_grow(Ipi_t* seed_ipi, uint16_t nblimbs)
                     /* Copy data from Ipi to new one and free old */
                     size = seed_ipi->num_limbs * CHARS_PER_LIMB;
                     CPS_BufferCopy((uint8_t*)p, (uint8_t*)seed_ipi->ptr, size);
-                    MEM_free(seed_ipi->ptr);
+                    ipi_free_limbs(seed_ipi->ptr);
                 }
 
                 seed_ipi->num_limbs = nblimbs;
@@ -441,6 +546,41 @@ static uint32_t ipi_grow(Ipi_t* seed_ipi, uint16_t nblimbs)
     return retVal;
 }
 
+/**
+ * Allocate limbs of empty Ipi from arena. If there is no space left in arena,
+ * limbs are allocated as for ipi_grow.
+ * @param[in, out] seed_ipi, empty IPI to grow
+ * @param[in] nblimbs, target number of limbs
+ * @return CDN_EOK if successful,
+ *         CDN_EINVAL if to many limbs needed,
+ *         CDN_ENOMEM if not enough memory
+ */
+static uint32_t ipi_grow_scoped(Ipi_t* seed_ipi, uint16_t nblimbs)
+{
+    uint32_t retVal = CDN_EOK;
+    uint32_t* p;
+
+    if ((nblimbs == 0U) || (nblimbs > CDN_IPI_MAX_LIMBS)) {
+        retVal = CDN_EINVAL;
+    } else if ((ipiArena.base != NULL) && (nblimbs <= (ipiArena.size - ipiArena.used))) {
+        p = &ipiArena.base[ipiArena.used];
+        ipiArena.used += nblimbs;
+
+        ipi_buffer_cleanup(p, ((uint32_t)nblimbs * CHARS_PER_LIMB));
+
+        seed_ipi->num_limbs = nblimbs;
+        seed_ipi->ptr = p;
+    } else {
+        retVal = ipi_grow(seed_ipi, nblimbs);
+
+        if (retVal == CDN_EOK) {
+            ipiArena.heapBytes += (uint32_t)nblimbs * CHARS_PER_LIMB;
+        }
+    }
+
+    return retVal;
+}
+
 /*
  * Return the number of used bits for all limbs
  * @param[in] src_ipi, pointer to Ipi
@@ -913,15 +1053,15 @@ static uint32_t ipi_size(const Ipi_t *src_ipi)
     return totalByteNum;
 }
 
-uint32_t ipi_rd_binary(Ipi_t *dest_ipi, const uint8_t* srcBuf, uint32_t bufLen)
+/**
+ * Returns number of bytes in big endian buffer without leading 0s
+ * @param[in] srcBuf, source buffer
+ * @param[in] bufLen, source buffer size
+ * @return number of significant bytes
+ */
+static uint32_t get_significant_bytes(const uint8_t* srcBuf, uint32_t bufLen)
 {
-    uint32_t retVal;
-    uint32_t full_limbs;
-    uint32_t number_of_bytes_in_part_limb;
     uint32_t i;
-    uint32_t index;
-    uint32_t number_of_limbs;
-    uint32_t bytes_to_copy;
 
     /* Remove trailing 0s */
     for (i = 0U; i < bufLen; i++) {
@@ -930,40 +1070,91 @@ uint32_t ipi_rd_binary(Ipi_t *dest_ipi, const uint8_t* srcBuf, uint32_t bufLen)
         }
     }
 
+    return bufLen - i;
+}
+
+/**
+ * Convert big endian buffer into limbs
+ * @param[out] limbs, pointer to limbs, all limbs of value are written
+ * @param[in] srcBuf, source buffer
+ * @param[in] bufLen, source buffer size
+ * @param[in] bytes_to_copy, number of significant bytes in source buffer
+ */
+static void rd_binary_to_limbs(uint32_t* limbs, const uint8_t* srcBuf, uint32_t bufLen, uint32_t bytes_to_copy)
+{
+    uint32_t number_of_bytes_in_part_limb = bytes_to_copy % NUMBER_OF_BYTES_IN_UINT32T;
+    uint32_t index = bufLen;
+    uint32_t i;
+
+    /* number of full limbs is (bytes_to_copy / NUMBER_OF_BYTES_IN_UINT32T) */
+    for (i = 0U; i < (bytes_to_copy / NUMBER_OF_BYTES_IN_UINT32T); i++) {
+        index -= NUMBER_OF_BYTES_IN_UINT32T;
+        limbs[i] = getBe32(&srcBuf[index]);
+    }
+
+    /* Still remaining data to read */
+    if (number_of_bytes_in_part_limb != 0U) {
+        index -= number_of_bytes_in_part_limb;
+
+        if (number_of_bytes_in_part_limb == 3U) {
+            limbs[i] = getBe24(&srcBuf[index]);
+        } else if (number_of_bytes_in_part_limb == 2U) {
+            limbs[i] = (uint32_t)getBe16(&srcBuf[index]);
+        } else {
+            /* For index = 1U */
+            limbs[i] = (uint32_t)srcBuf[index];
+        }
+    }
+}
+
+uint32_t ipi_rd_binary(Ipi_t *dest_ipi, const uint8_t* srcBuf, uint32_t bufLen)
+{
+    uint32_t retVal;
+    uint32_t number_of_limbs;
     /* Number of bytes in source buffer without trailing 0s */
-    bytes_to_copy = bufLen - i;
+    uint32_t bytes_to_copy = get_significant_bytes(srcBuf, bufLen);
 
     number_of_limbs = chars_to_limbs(bytes_to_copy);
 
     if (number_of_limbs < CDN_IPI_MAX_LIMBS) {
-        retVal = ipi_setup(dest_ipi, (uint16_t)number_of_limbs);
+        /* Old value is overwritten, so it is not copied into grown Ipi */
+        if (dest_ipi->num_limbs < number_of_limbs) {
+            ipi_free(dest_ipi);
+        }
+
+        retVal = ipi_grow(dest_ipi, (uint16_t)number_of_limbs);
     } else {
         retVal = CDN_EINVAL;
     }
 
     if (retVal == CDN_EOK) {
-        number_of_bytes_in_part_limb = bytes_to_copy % NUMBER_OF_BYTES_IN_UINT32T;
-        index = bufLen;
+        dest_ipi->sign = IPI_POSITIVE_VAL;
 
-        /* number of full limbs is (bytes_to_copy / NUMBER_OF_BYTES_IN_UINT32T) */
-        for (i = 0U; i < (bytes_to_copy / NUMBER_OF_BYTES_IN_UINT32T); i++) {
-            index -= NUMBER_OF_BYTES_IN_UINT32T;
-            dest_ipi->ptr[i] = getBe32(&srcBuf[index]);
-        }
+        /* Only limbs above value need clean-up, the rest is written word by word */
+        ipi_buffer_cleanup(&dest_ipi->ptr[number_of_limbs],
+                           ((uint32_t)dest_ipi->num_limbs - number_of_limbs) * CHARS_PER_LIMB);
+        rd_binary_to_limbs(dest_ipi->ptr, srcBuf, bufLen, bytes_to_copy);
+    }
 
-        /* Still remaining data to read */
-        if (number_of_bytes_in_part_limb != 0U) {
-            index -= number_of_bytes_in_part_limb;
+    return retVal;
+}
 
-            if (number_of_bytes_in_part_limb == 3U) {
-                dest_ipi->ptr[i] = getBe24(&srcBuf[index]);
-            } else if (number_of_bytes_in_part_limb == 2U) {
-                dest_ipi->ptr[i] = (uint32_t)getBe16(&srcBuf[index]);
-            } else {
-                /* For index = 1U */
-                dest_ipi->ptr[i] = (uint32_t)srcBuf[index];
-            }
-        }
+uint32_t ipi_rd_binary_static(Ipi_t *dest_ipi, uint32_t* limbs, uint16_t limbsNum,
+                              const uint8_t* srcBuf, uint32_t bufLen)
+{
+    uint32_t retVal = CDN_EOK;
+    uint32_t bytes_to_copy = get_significant_bytes(srcBuf, bufLen);
+    uint32_t number_of_limbs = chars_to_limbs(bytes_to_copy);
+
+    ipi_init(dest_ipi);
+
+    if ((number_of_limbs == 0U) || (number_of_limbs > limbsNum)) {
+        retVal = CDN_EINVAL;
+    } else {
+        rd_binary_to_limbs(limbs, srcBuf, bufLen, bytes_to_copy);
+
+        dest_ipi->num_limbs = (uint16_t)number_of_limbs;
+        dest_ipi->ptr = limbs;
     }
 
     return retVal;
@@ -1034,9 +1225,8 @@ uint32_t ipi_wr_binary (const Ipi_t* src_ipi, uint8_t* destBuf, uint32_t bufLen)
 
     if (retVal == CDN_EOK) {
 
-        for (i = 0U; i < bufLen; i++) {
-            destBuf[i] = 0U;
-        }
+        /* Only leading bytes are cleaned, the rest is written word by word */
+        (void)memset(destBuf, 0, bufLen - ipiSize);
 
         fullLimbs = ipiSize / CHARS_PER_LIMB;
         partialLimbs = ipiSize % CHARS_PER_LIMB;
@@ -1080,6 +1270,26 @@ static void ipi_montg_init(uint32_t* mm, const Ipi_t* N)
     *mm = ~x + 1U;
 }
 
+#if XCHAL_HAVE_MUL32_HIGH
+/**
+ * Multiply-accumulate of single limb: (carry, dest) = multiplier * multiplicand + carry + dest.
+ * Core has MUL32 and MULUH instructions, so full 64-bit product is calculated with two
+ * instructions, without splitting limbs into half-words
+ * @param[in] multiplier, limb of right-hand Ipi
+ * @param[in] multiplicand, limb of left-hand Ipi
+ * @param[in] carry, value of carriage
+ * @param[in, out] dest, pointer to result limb
+ * @return new value of carriage
+ */
+static inline uint32_t mul_add_limb(uint32_t multiplier, uint32_t multiplicand, uint32_t carry, uint32_t* dest)
+{
+    uint64_t result = ((uint64_t)multiplier * (uint64_t)multiplicand) + (uint64_t)carry + (uint64_t)*dest;
+
+    *dest = GetDword0(result);
+
+    return GetDword1(result);
+}
+#else
 /**
  * Used to convert double word to array with words
  * @param[in] multiplicant, double word value
@@ -1164,6 +1374,34 @@ static inline void calc_r_matrix(uint32_t r_matrix[MUL_MATRIX_DIMENSION_SIZE][MU
 
 }
 
+/**
+ * Multiply-accumulate of single limb: (carry, dest) = multiplier * multiplicand + carry + dest.
+ * Core has no MULUH instruction, so limbs are split into half-words
+ * @param[in] multiplier, limb of right-hand Ipi
+ * @param[in] multiplicand, limb of left-hand Ipi
+ * @param[in] carry, value of carriage
+ * @param[in, out] dest, pointer to result limb
+ * @return new value of carriage
+ */
+static inline uint32_t mul_add_limb(uint32_t multiplier, uint32_t multiplicand, uint32_t carry, uint32_t* dest)
+{
+    uint32_t r_help_matrix[MUL_MATRIX_DIMENSION_SIZE][MUL_MATRIX_DIMENSION_SIZE];
+    uint32_t multiplicand_as_words[MUL_MATRIX_DIMENSION_SIZE];
+    uint32_t multiplier_as_words[MUL_MATRIX_DIMENSION_SIZE];
+
+    mulladdc_init(multiplicand_as_words, multiplicand);
+    mulladdc_init(multiplier_as_words, multiplier);
+
+    calc_r_matrix(r_help_matrix, multiplicand_as_words, multiplier_as_words, carry, *dest);
+
+    // *d = r0;
+    *dest = r_help_matrix[0][0];
+
+    // c = r1
+    return r_help_matrix[1][1];
+}
+#endif /* XCHAL_HAVE_MUL32_HIGH */
+
 /**
  * Used to correct multiplication procedure
  * @param[in] result, double pointer to current result limb
@@ -1183,30 +1421,17 @@ static inline void mulladdc_finish(uint32_t** result, uint32_t carry)
 /**
  * Core of multiplication procedure
  * @param[in] multiplier, double pointer to multiplier value
- * @param[in] multiplicand_as_words, value of used multiplicand limbs cut into words
+ * @param[in] multiplicand, value of used multiplicand limb
  * @param[in] carry, pointer to carraige
  * @param[in, out] dest, double pointer to result buffer
  * @param[in] index, number of iterations in one step
  * */
-static void mulladdc_core(uint32_t** multiplier, const uint32_t multiplicand_as_words[2], uint32_t* carry, uint32_t** dest, uint32_t index)
+static inline void mulladdc_core(const uint32_t** multiplier, uint32_t multiplicand, uint32_t* carry, uint32_t** dest, uint32_t index)
 {
-    /* Function is called many times, static to avoid allocate/deallocate each time */
-    static uint32_t multiplier_as_words[2];
-    static uint32_t r_help_matrix[2][2];
     uint32_t i;
 
     for (i = 0U; i < index; i++) {
-        // s0 = ( *s << BITS_PER_HALF_LIMB ) >> BITS_PER_HALF_LIMB
-        multiplier_as_words[0] = GetWord0(**multiplier);
-        // s1 = ( *s >> BITS_PER_HALF_LIMB )
-        multiplier_as_words[1] = GetWord1(**multiplier);
-
-        calc_r_matrix(r_help_matrix, multiplicand_as_words, multiplier_as_words, *carry, **dest);
-
-        // c = r1
-        *carry = r_help_matrix[1][1];
-        // *(d++) = r0;
-        **dest = r_help_matrix[0][0];
+        *carry = mul_add_limb(**multiplier, multiplicand, *carry, *dest);
 
         (*dest)++;
         (*multiplier)++;
@@ -1214,36 +1439,35 @@ static void mulladdc_core(uint32_t** multiplier, const uint32_t multiplicand_as_
 }
 
 /**
- * Helper function used during multiplication
+ * Helper function used during multiplication. Steps have constant number of iterations,
+ * so they are unrolled by compiler
  * @param[in] i, number of iterations to do
  * @param[in] multiplier, pointer right-hand Ipi buffer
  * @param[out] result, pointer to buffer with result
  * @param[in] multiplicand, pointer to buffer with left-hand Ipi buffer
  */
-static void ipi_mul_hlp(uint32_t i, uint32_t* multiplier /* *s*/, uint32_t* result /* *d */, uint32_t multiplicand /* b */)
+static inline void ipi_mul_hlp(uint32_t i, const uint32_t* multiplier /* *s*/, uint32_t* result /* *d */, uint32_t multiplicand /* b */)
 {
-    uint32_t multiplicand_as_words[2];
+    const uint32_t* l_multiplier = multiplier;
+    uint32_t* l_result = result;
     uint32_t carry = 0U;
     uint32_t index = i;
 
-    /* Start multiplication */
-    mulladdc_init(multiplicand_as_words, multiplicand);
-
     /* Make iterations as long as i will be 0 */
     for( ; index >= 16U; index -= 16U ) {
-        mulladdc_core(&multiplier, multiplicand_as_words, &carry, &result, 16U);
+        mulladdc_core(&l_multiplier, multiplicand, &carry, &l_result, 16U);
     }
 
     for( ; index >= 8U; index -= 8U ) {
-        mulladdc_core(&multiplier, multiplicand_as_words, &carry, &result, 8U);
+        mulladdc_core(&l_multiplier, multiplicand, &carry, &l_result, 8U);
     }
 
     for( ; index > 0U; index-- ) {
-        mulladdc_core(&multiplier, multiplicand_as_words, &carry, &result, 1U);
+        mulladdc_core(&l_multiplier, multiplicand, &carry, &l_result, 1U);
     }
 
     /* Finish multiplication */
-    mulladdc_finish(&result, carry);
+    mulladdc_finish(&l_result, carry);
 }
 
 
@@ -1326,6 +1550,8 @@ static uint32_t ipi_mul_uint(Ipi_t* dest_ipi, const Ipi_t* A, uint32_t b)
         retVal = ipi_mul(dest_ipi, A, &uintAsIpi);
     }
 
+    ipi_free(&uintAsIpi);
+
     return retVal;
 }
 
@@ -1818,37 +2044,123 @@ static uint32_t ipi_mod_splited_mode( Ipi_t *R, const Ipi_t *A, const Ipi_t *B )
 }
 
 /*
- * Montgomery multiplication helper function
- * @param[in] A, left-hand Ipi
- * @param[in] B, reight-hand Ipi
- * @param[in] N, modulus value
+ * Rows of Montgomery multiplication: T = (A * B + m * N), one limb of A per row.
+ * Inlined with constant sizes by size-specialized kernels
+ * @param[in] A, pointer to left-hand Ipi buffer
+ * @param[in] B, pointer to right-hand Ipi buffer
+ * @param[in] m, number of used limbs of B
+ * @param[in] N, pointer to modulus buffer
+ * @param[in] n_limbs, number of limbs of modulus
  * @param[in] mm, montgomery specified value
- * @param[out] T, temporary buffer to store Ipi data
+ * @param[out] T, pointer to temporary buffer
  */
-static void ipi_montmul_hlp(const Ipi_t *A, const Ipi_t *B, const Ipi_t *N, uint32_t mm, const Ipi_t *T)
+static inline void montmul_rows(const uint32_t* A, const uint32_t* B, uint32_t m,
+                                const uint32_t* N, uint32_t n_limbs, uint32_t mm, uint32_t* T)
 {
-    uint16_t n_limbs = N->num_limbs;
-    uint32_t m = (B->num_limbs < n_limbs) ? B->num_limbs : n_limbs;
     uint32_t* temp_buffer;
     uint32_t temp_val;
     uint32_t a_val;
-    uint16_t i;
+    uint32_t i;
 
     /* Iterate through all limbs */
     for( i = 0U; i < n_limbs; i++ ) {
 
-        temp_buffer = &T->ptr[i];
-        a_val = A->ptr[i];
-        temp_val = (*temp_buffer + (a_val * B->ptr[0] )) * mm;
+        temp_buffer = &T[i];
+        a_val = A[i];
+        temp_val = (*temp_buffer + (a_val * B[0] )) * mm;
 
-        ipi_mul_hlp( m, B->ptr, temp_buffer, a_val);
-        ipi_mul_hlp( n_limbs, N->ptr, temp_buffer, temp_val);
+        ipi_mul_hlp( m, B, temp_buffer, a_val);
+        ipi_mul_hlp( n_limbs, N, temp_buffer, temp_val);
 
         *temp_buffer = a_val;
         temp_buffer[n_limbs + 2U] = 0U;
     }
 }
 
+/*
+ * Rows of Montgomery reduction: T = T + m * N, where m makes lower half of T equal 0.
+ * Inlined with constant sizes by size-specialized kernels
+ * @param[in] N, pointer to modulus buffer
+ * @param[in] n_limbs, number of limbs of modulus
+ * @param[in] mm, montgomery specified value
+ * @param[in, out] T, pointer to reduced buffer
+ */
+static inline void montred_rows(const uint32_t* N, uint32_t n_limbs, uint32_t mm, uint32_t* T)
+{
+    uint32_t i;
+
+    for (i = 0U; i < n_limbs; i++) {
+        ipi_mul_hlp(n_limbs, N, &T[i], T[i] * mm);
+    }
+}
+
+/** Montgomery multiplication kernel for 1024-bit modulus (public key of receiver) */
+static void montmul_rows_1024(const uint32_t* A, const uint32_t* B, const uint32_t* N, uint32_t mm, uint32_t* T)
+{
+    montmul_rows(A, B, MONT_KERNEL_1024_LIMBS, N, MONT_KERNEL_1024_LIMBS, mm, T);
+}
+
+/** Montgomery multiplication kernel for 3072-bit modulus (DCP LLC public key) */
+static void montmul_rows_3072(const uint32_t* A, const uint32_t* B, const uint32_t* N, uint32_t mm, uint32_t* T)
+{
+    montmul_rows(A, B, MONT_KERNEL_3072_LIMBS, N, MONT_KERNEL_3072_LIMBS, mm, T);
+}
+
+/** Montgomery reduction kernel for 1024-bit modulus (public key of receiver) */
+static void montred_rows_1024(const uint32_t* N, uint32_t mm, uint32_t* T)
+{
+    montred_rows(N, MONT_KERNEL_1024_LIMBS, mm, T);
+}
+
+/** Montgomery reduction kernel for 3072-bit modulus (DCP LLC public key) */
+static void montred_rows_3072(const uint32_t* N, uint32_t mm, uint32_t* T)
+{
+    montred_rows(N, MONT_KERNEL_3072_LIMBS, mm, T);
+}
+
+/*
+ * Montgomery multiplication helper function. Uses kernel specialized for size of
+ * modulus if available
+ * @param[in] A, left-hand Ipi
+ * @param[in] B, reight-hand Ipi
+ * @param[in] N, modulus value
+ * @param[in] mm, montgomery specified value
+ * @param[out] T, temporary buffer to store Ipi data
+ */
+static void ipi_montmul_hlp(const Ipi_t *A, const Ipi_t *B, const Ipi_t *N, uint32_t mm, const Ipi_t *T)
+{
+    uint16_t n_limbs = N->num_limbs;
+    uint32_t m = (B->num_limbs < n_limbs) ? B->num_limbs : n_limbs;
+
+    if ((m == MONT_KERNEL_1024_LIMBS) && (n_limbs == MONT_KERNEL_1024_LIMBS)) {
+        montmul_rows_1024(A->ptr, B->ptr, N->ptr, mm, T->ptr);
+    } else if ((m == MONT_KERNEL_3072_LIMBS) && (n_limbs == MONT_KERNEL_3072_LIMBS)) {
+        montmul_rows_3072(A->ptr, B->ptr, N->ptr, mm, T->ptr);
+    } else {
+        montmul_rows(A->ptr, B->ptr, m, N->ptr, n_limbs, mm, T->ptr);
+    }
+}
+
+/*
+ * Montgomery reduction helper function. Uses kernel specialized for size of
+ * modulus if available
+ * @param[in] N, modulus value
+ * @param[in] mm, montgomery specified value
+ * @param[in, out] T, reduced buffer
+ */
+static void ipi_montred_hlp(const Ipi_t *N, uint32_t mm, const Ipi_t *T)
+{
+    uint16_t n_limbs = N->num_limbs;
+
+    if (n_limbs == MONT_KERNEL_1024_LIMBS) {
+        montred_rows_1024(N->ptr, mm, T->ptr);
+    } else if (n_limbs == MONT_KERNEL_3072_LIMBS) {
+        montred_rows_3072(N->ptr, mm, T->ptr);
+    } else {
+        montred_rows(N->ptr, n_limbs, mm, T->ptr);
+    }
+}
+
 /*
  * Montgomery multiplication: A = A * B * R^-1 mod N  (HAC 14.36)
  * @param[in] A, left-hand Ipi
@@ -1883,6 +2195,78 @@ static void ipi_montmul( Ipi_t *A, const Ipi_t *B, const Ipi_t *N, uint32_t mm,
     }
 }
 
+/**
+ * Helper function used to double cross products and add squares of limbs during squaring
+ * @param[in] A, pointer to squared Ipi buffer
+ * @param[in, out] result, pointer to buffer with cross products
+ * @param[in] n_limbs, number of limbs of squared Ipi
+ */
+static void ipi_sqr_diag_hlp(const uint32_t* A, uint32_t* result, uint16_t n_limbs)
+{
+    uint32_t high;
+    uint32_t carry = 0U;
+    uint32_t temp;
+    uint32_t i;
+
+    /* Cross products are added twice, so shift them left by one bit */
+    for (i = 0U; i < ((uint32_t)n_limbs * 2U); i++) {
+        temp = safe_shift32r(result[i], BITS_PER_LIMB - 1U);
+        result[i] = safe_shift32l(result[i], 1U) | carry;
+        carry = temp;
+    }
+
+    carry = 0U;
+
+    /* Add squares of limbs on diagonal: result[2i + 1, 2i] += A[i] * A[i] */
+    for (i = 0U; i < n_limbs; i++) {
+        high = mul_add_limb(A[i], A[i], carry, &result[2U * i]);
+
+        result[(2U * i) + 1U] += high;
+        carry = bool_to_uint(result[(2U * i) + 1U] < high);
+    }
+}
+
+/*
+ * Montgomery squaring: A = A * A * R^-1 mod N
+ * Each cross product A[i] * A[j] (i < j) is calculated only once and doubled,
+ * so about half of multiplications done by ipi_montmul is saved.
+ * @param[in] A, squared Ipi
+ * @param[in] N, modulus value
+ * @param[in] mm, montgomery specified value
+ * @param[out] T, temporary buffer to store Ipi data
+ */
+static void ipi_montsqr( Ipi_t *A, const Ipi_t *N, uint32_t mm, const Ipi_t *T )
+{
+    uint16_t n_limbs = N->num_limbs;
+    uint16_t i;
+
+    ipi_buffer_cleanup(T->ptr, ((uint32_t)T->num_limbs * CHARS_PER_LIMB));
+
+    /* T = sum of A[i] * A[j] for i < j */
+    for (i = 0U; (i + 1U) < n_limbs; i++) {
+        ipi_mul_hlp(((uint32_t)n_limbs - i) - 1U, &A->ptr[i + 1U], &T->ptr[(2U * i) + 1U], A->ptr[i]);
+    }
+
+    /* T = A * A */
+    ipi_sqr_diag_hlp(A->ptr, T->ptr, n_limbs);
+
+    /* T = T + m * N, where m makes lower half of T equal 0 */
+    ipi_montred_hlp(N, mm, T);
+
+    /* Copy results into buffer */
+    CPS_BufferCopy((volatile uint8_t*)A->ptr,
+                   (volatile uint8_t*)&T->ptr[n_limbs],
+                   (((uint32_t)n_limbs + 1U) * CHARS_PER_LIMB));
+
+    /* Correct results */
+    if( ipi_cmp_abs( A, N ) != COMPARISON_RESULT_LOWER) {
+        ipi_sub_hlp( n_limbs, N->ptr, A->ptr );
+    } else {
+        /* Prevent timing attacks */
+        ipi_sub_hlp( n_limbs, A->ptr, T->ptr );
+    }
+}
+
 /*
  * Montgomery reduction: A = A * R^-1 mod N
  * @param[in] A, left-hand Ipi
@@ -1910,18 +2294,19 @@ static void ipi_montred( Ipi_t *A, const Ipi_t *N, uint32_t mm, const Ipi_t *T )
  */
 static void init_bit_iterator(Limb2BitIterator_t* iterator, const Ipi_t* ipiPtr)
 {
-    uint32_t index;
+    uint32_t bits = ipi_msb_bitsnum(ipiPtr);
 
-    iterator->limbs_number = ipiPtr->num_limbs - 1U;
-
-    /* Get number of bits in last limb (if limb is not full)*/
-    index = (ipi_msb_bitsnum(ipiPtr) % BITS_PER_LIMB);
-    if (index == 0U) {
-        iterator->bit_number = NUMBER_OF_BITS_IN_UINT8_T - 1U;
-    } else {
-        iterator->bit_number = (uint8_t)index;
+    /* Zero is iterated as single 0 bit */
+    if (bits == 0U) {
+        bits = 1U;
     }
 
+    /* Start from the most significant used limb */
+    iterator->limbs_number = (uint16_t)((bits - 1U) / BITS_PER_LIMB);
+
+    /* Get number of bits in that limb */
+    iterator->bit_number = (uint8_t)(bits - ((uint32_t)iterator->limbs_number * BITS_PER_LIMB));
+
     iterator->ipiPtr = ipiPtr->ptr;
     iterator->isDone = false;
 }
@@ -1955,7 +2340,7 @@ static uint8_t get_next_bit(Limb2BitIterator_t* iterator)
 
     /* Get next limb */
     if (iterator->bit_number == 0U) {
-        iterator->bit_number = NUMBER_OF_BITS_IN_UINT8_T - 1U;
+        iterator->bit_number = BITS_PER_LIMB;
 
         if (iterator->limbs_number != 0U) {
             iterator->limbs_number--;
@@ -1968,38 +2353,108 @@ static uint8_t get_next_bit(Limb2BitIterator_t* iterator)
 }
 
 
+/**
+ * Modular doubling: X = 2 * X mod N
+ * @param[in, out] X, doubled Ipi, lower than N, with at least N->num_limbs + 1 limbs
+ * @param[in] N, modulus value
+ */
+static void ipi_mod_double(const Ipi_t* X, const Ipi_t* N)
+{
+    uint16_t n_limbs = N->num_limbs;
+    uint32_t carry = 0U;
+    uint32_t temp;
+    uint16_t i;
+
+    /* Shift left by one bit, last limb takes carry */
+    for (i = 0U; i <= n_limbs; i++) {
+        temp = safe_shift32r(X->ptr[i], BITS_PER_LIMB - 1U);
+        X->ptr[i] = safe_shift32l(X->ptr[i], 1U) | carry;
+        carry = temp;
+    }
+
+    /* 2 * X is lower than 2 * N, so single subtraction is enough */
+    if (ipi_cmp_abs(X, N) != COMPARISON_RESULT_LOWER) {
+        ipi_sub_hlp(n_limbs, N->ptr, X->ptr);
+    }
+}
+
+/**
+ * Calculates 2^k * R mod N, which gives R^2 mod N after j Montgomery squarings,
+ * where k * 2^j = BITS_PER_LIMB * N->num_limbs. Division is not needed, because
+ * only modular doubling starting from highest power of 2 lower than N is used.
+ */
 static uint32_t exp_prereq_calc_r2_handler(void)
 {
     uint32_t retVal;
-    uint8_t i = 0U;
     Ipi_t* RR = &expModHlp.Z;
+    const Ipi_t* N = expModHlp.N;
+    uint32_t k = N->num_limbs;
+    uint32_t doublings;
+    uint32_t top_bit;
+    uint32_t i;
 
-    retVal  = ipi_lset(RR, 1);
+    /* Get odd k and j */
+    expModHlp.rr_squarings = BITS_PER_LIMB_LOG2;
+    while ((k & 1U) == 0U) {
+        k = safe_shift32r(k, 1U);
+        expModHlp.rr_squarings++;
+    }
 
-    /* Shift in 'while' to avoid overflow numbers of shifting */
-    while ((i < (BITS_PER_LIMB * 2U)) && (retVal == CDN_EOK)) {
-        retVal |= ipi_shift_l(RR, (uint32_t)expModHlp.N->num_limbs);
-        i++;
+    retVal = ipi_setup(RR, N->num_limbs + 1U);
+
+    if (retVal == CDN_EOK) {
+        /* RR = 2^(top_bit) is lower than N */
+        top_bit = ipi_msb_bitsnum(N) - 1U;
+        RR->ptr[top_bit / BITS_PER_LIMB] = safe_shift32l(1U, top_bit % BITS_PER_LIMB);
+
+        /* RR = 2^(BITS_PER_LIMB * N->num_limbs + k) mod N = 2^k * R mod N */
+        doublings = ((BITS_PER_LIMB * (uint32_t)N->num_limbs) + k) - top_bit;
+        for (i = 0U; i < doublings; i++) {
+            ipi_mod_double(RR, N);
+        }
     }
 
-    lib_handler.expModCalcCb = &exp_prereq_calc_mod_handler;
+    lib_handler.expModCalcCb = &exp_prereq_calc_r2_sqr_handler;
 
     return retVal;
 }
 
-static uint32_t exp_prereq_calc_mod_handler(void)
+/**
+ * Store calculated R^2 mod N in Montgomery context, if context is used and not ready yet
+ */
+static void store_mont_ctx(void)
+{
+    IpiMontCtx_t* ctx = expModHlp.ctx;
+    const Ipi_t* RR = &expModHlp.Z;
+
+    if ((ctx != NULL) && (!ctx->isReady)) {
+        /* R^2 mod N is lower than N, so it fits in context buffer */
+        ipi_buffer_cleanup(ctx->RR.ptr, ((uint32_t)ctx->RR.num_limbs * CHARS_PER_LIMB));
+        CPS_BufferCopy((uint8_t*)ctx->RR.ptr, (uint8_t*)RR->ptr,
+                       ((uint32_t)get_num_of_used_limbs(RR) * CHARS_PER_LIMB));
+        ctx->isReady = true;
+    }
+}
+
+/**
+ * Makes one Montgomery squaring of 2^k * R mod N per call:
+ * (2^k * R)^2 * R^-1 = 2^(2k) * R mod N
+ */
+static uint32_t exp_prereq_calc_r2_sqr_handler(void)
 {
-    uint32_t retVal;
     /* Use Z as temporary buffer */
     Ipi_t* localIpi = &expModHlp.Z;
 
-    retVal = ipi_mod_splited_mode(localIpi, localIpi, expModHlp.N);
+    ipi_montsqr(localIpi, expModHlp.N, expModHlp.mm, &expModHlp.T);
+    expModHlp.rr_squarings--;
 
-    if (retVal != CDN_EINPROGRESS) {
+    if (expModHlp.rr_squarings == 0U) {
+        /* Z = R^2 mod N */
+        store_mont_ctx();
         lib_handler.expModCalcCb = &exp_prereq_calc_x_dash_handler;
     }
 
-    return retVal;
+    return CDN_EOK;
 }
 
 static uint32_t exp_prereq_calc_x_dash_handler(void)
@@ -2007,7 +2462,7 @@ static uint32_t exp_prereq_calc_x_dash_handler(void)
     uint32_t retVal;
     /* Use A as temporary buffer - data is copied there at the end of prerequesities procedure*/
     Ipi_t* localIpi = &expModHlp.Z;
-    Ipi_t* x_dash = &expModHlp.W[1];
+    Ipi_t* x_dash = &expModHlp.W[0];
     const Ipi_t* m = expModHlp.N;
 
     // TODO: how remove checking each time ?
@@ -2029,63 +2484,79 @@ static uint32_t exp_prereq_calc_a_handler(void)
 {
     /* Use A as temporary buffer - data is copied there at the end of prerequesities procedure*/
     Ipi_t* localIpi = &expModHlp.Z;
+    uint32_t retVal;
+
+    if (expModHlp.e_small_bits > 0U) {
+        /* Most significant bit of exponent is always set, so start from A * R mod N */
+        expModHlp.e_small_bits--;
+
+        if (expModHlp.e_small_bits > 0U) {
+            lib_handler.expModCalcCb = &do_small_exp;
+        } else {
+            lib_handler.expModCalcCb = &correct_exp_result;
+        }
 
-    if( expModHlp.window_size > 1U ) {
-            lib_handler.expModCalcCb = &calculate_g;
+        retVal = ipi_copy(expModHlp.ipiPtr, &expModHlp.W[0]);
     } else {
-            lib_handler.expModCalcCb = &do_sliding_window_exp;
+
+        if( expModHlp.window_size > 1U ) {
+                lib_handler.expModCalcCb = &calculate_g;
+        } else {
+                lib_handler.expModCalcCb = &do_sliding_window_exp;
+        }
+
+        /* X = R^2 * R^-1 mod N = R mod N */
+        ipi_montred(localIpi, expModHlp.N, expModHlp.mm, &expModHlp.T);
+        retVal = ipi_copy(expModHlp.ipiPtr, localIpi);
     }
 
-    /* X = R^2 * R^-1 mod N = R mod N */
-    ipi_montred(localIpi, expModHlp.N, expModHlp.mm, &expModHlp.T);
-    return ipi_copy(expModHlp.ipiPtr, localIpi);
+    return retVal;
 }
 
-/** Used to calculate array of used multiplicands */
+/**
+ * Get number of odd powers needed for current window
+ * @return number of W table entries
+ */
+static inline uint8_t get_table_size(void)
+{
+    return (uint8_t)safe_shift32l(1U, (uint32_t)expModHlp.window_size - 1U);
+}
+
+/** Used to calculate table of odd powers: W[i] = A^(2i+1) * R mod N */
 static uint32_t calculate_g(void)
 {
     uint8_t i;
     uint32_t retVal;
-    const uint8_t last_window_bit_index = expModHlp.window_size - 1U;
     const Ipi_t* N = expModHlp.N;
-    const uint32_t last_window_bit_mask = safe_shift32l(1U, last_window_bit_index);
-    const uint16_t limb_size = N->num_limbs + 1U;
-
-    Ipi_t* current_w = &expModHlp.W[last_window_bit_mask];
+    /* Z is not used anymore, keep A^2 * R mod N there */
+    Ipi_t* a_sqr = &expModHlp.Z;
 
-    retVal  = ipi_grow(current_w, limb_size);
-    retVal |= ipi_copy(current_w, &expModHlp.W[1]);
+    retVal = ipi_copy(a_sqr, &expModHlp.W[0]);
 
     if (retVal == CDN_EOK) {
 
-        /* Calculate base value of multiplicand */
-        for (i = 0U; i < last_window_bit_index; i++) {
-            ipi_montmul(current_w, current_w, N, expModHlp.mm, &expModHlp.T );
-        }
-
-        i++;
+        ipi_montsqr(a_sqr, N, expModHlp.mm, &expModHlp.T);
 
-        /* Iterate over rest of items */
-        for ( ; i < (uint8_t)safe_shift32l(1U, expModHlp.window_size); i++) {
+        for (i = 1U; i < get_table_size(); i++) {
 
-            current_w = &expModHlp.W[i];
-
-            retVal  = ipi_grow(current_w, limb_size);
-            retVal |= ipi_copy(current_w, &expModHlp.W[i - 1U]);
+            retVal = ipi_copy(&expModHlp.W[i], &expModHlp.W[i - 1U]);
 
             if (retVal == CDN_EOK) {
-                ipi_montmul(current_w, current_w, N, expModHlp.mm, &expModHlp.T);
+                ipi_montmul(&expModHlp.W[i], a_sqr, N, expModHlp.mm, &expModHlp.T);
             } else {
                 break;
             }
         }
     }
 
+    lib_handler.expModCalcCb = &do_sliding_window_exp;
+
     return retVal;
 }
 
 /**
- * Return size of required window
+ * Return size of required window. Thresholds minimize number of multiplications:
+ * 2^(size-1) to build odd powers table and about bits/(size+1) for windows.
  * @param[in] ipi, pointer to Ipi on which window will be constructed
  * @returns window size
  */
@@ -2106,6 +2577,10 @@ static inline uint8_t get_window_size(const Ipi_t* ipi)
         windowSize = 1U;
     }
 
+    if (windowSize > IPI_EXP_MAX_WINDOW_SIZE) {
+        windowSize = IPI_EXP_MAX_WINDOW_SIZE;
+    }
+
     return windowSize;
 
 }
@@ -2124,12 +2599,9 @@ typedef struct {
  */
 static void update_window(Window_t* window_ptr, uint8_t ei)
 {
-    uint8_t curr_window_bit_pos;
     window_ptr->number_of_bits++;
 
-    curr_window_bit_pos = window_ptr->window_size - window_ptr->number_of_bits;
-
-    window_ptr->window_bits |= (uint8_t)safe_shift32l(ei, curr_window_bit_pos);
+    window_ptr->window_bits = (uint8_t)safe_shift32l(window_ptr->window_bits, 1U) | ei;
 
     window_ptr->is_window_full = (window_ptr->number_of_bits == window_ptr->window_size);
 }
@@ -2146,33 +2618,51 @@ static void cleanup_window(Window_t* window_ptr)
 }
 
 /**
- * Finish sliding window exponentation step
+ * Apply bits collected in window to result. Window always starts with 1,
+ * trailing zeros are squared after multiplication, so only odd powers are used.
  * @param[in] window_ptr, pointer to window
  */
-static void finish_sliding_window_exp(Window_t* window_ptr)
+static void apply_window(Window_t* window_ptr)
 {
-    uint32_t mask = safe_shift32l(1U, window_ptr->window_size);
+    uint8_t zeros = 0U;
     uint8_t i;
 
     const Ipi_t* N = expModHlp.N;
     Ipi_t* result = expModHlp.ipiPtr;
 
-    /* Process the remaining bits */
-    for (i = 0U; i < window_ptr->number_of_bits; i++) {
+    while ((window_ptr->window_bits & 1U) == 0U) {
+        window_ptr->window_bits = (uint8_t)safe_shift32r(window_ptr->window_bits, 1U);
+        zeros++;
+    }
 
-        ipi_montmul(result, result, N, expModHlp.mm, &expModHlp.T);
+    for (i = zeros; i < window_ptr->number_of_bits; i++) {
+        ipi_montsqr(result, N, expModHlp.mm, &expModHlp.T);
+    }
 
-        window_ptr->window_bits = (uint8_t)safe_shift32l(window_ptr->window_bits, 1U);
+    /* result = result * A^(window_bits) * R * R^-1 mod N */
+    ipi_montmul(result, &expModHlp.W[safe_shift32r(window_ptr->window_bits, 1U)], N, expModHlp.mm, &expModHlp.T);
 
-        if ((window_ptr->window_bits & mask) != 0U) {
-            ipi_montmul(result, &expModHlp.W[1], N, expModHlp.mm, &expModHlp.T);
-        }
+    for (i = 0U; i < zeros; i++) {
+        ipi_montsqr(result, N, expModHlp.mm, &expModHlp.T);
     }
 
-    lib_handler.expModCalcCb = &correct_exp_result;
     cleanup_window(window_ptr);
 }
 
+/**
+ * Finish sliding window exponentation step
+ * @param[in] window_ptr, pointer to window
+ */
+static void finish_sliding_window_exp(Window_t* window_ptr)
+{
+    /* Process the remaining bits */
+    if (window_ptr->number_of_bits != 0U) {
+        apply_window(window_ptr);
+    }
+
+    lib_handler.expModCalcCb = &correct_exp_result;
+}
+
 /**
  * Used to make slinding window exponetation phase. Each call of functions mean one iteration
  * @return CDN_EOK if success,
@@ -2182,19 +2672,15 @@ static uint32_t do_sliding_window_exp(void)
 {
     uint8_t ei;
     Ipi_t* dest_ipi = expModHlp.ipiPtr;
-    const Ipi_t* N = expModHlp.N;
     uint32_t retVal;
     static Window_t window = {0U, 0U, false, 0U};
-    uint8_t i;
-    uint32_t mm = expModHlp.mm;
-    Ipi_t* temp_ipi = &expModHlp.T;
     Limb2BitIterator_t* limb_to_bit_iterator = &expModHlp.e_iterator;
 
     ei = get_next_bit(limb_to_bit_iterator);
 
     if((ei == 0U) && (window.number_of_bits == 0U)) {
         /* Out of window, square dest_ipi */
-        ipi_montmul( dest_ipi, dest_ipi, N, mm, temp_ipi);
+        ipi_montsqr(dest_ipi, expModHlp.N, expModHlp.mm, &expModHlp.T);
     } else {
         /* Add ei to current window */
 
@@ -2202,19 +2688,7 @@ static uint32_t do_sliding_window_exp(void)
         update_window(&window, ei);
 
         if (window.is_window_full) {
-
-            /* Take any 6b sequence. We need do (i-l+1) squaring of A if ei = 1,
-             * and (6-i+l-1) for padding zeros. So for any 6b sequence we need do
-             * (i-l+1+6-i+l-1) = 6 squaring operations */
-            for (i = 0U; i < window.window_size; i++) {
-                ipi_montmul(dest_ipi, dest_ipi, N, mm, temp_ipi );
-            }
-
-            /* dest_ipi = dest_ipi * W[current_window] R^-1 mod N */
-            ipi_montmul(dest_ipi, &expModHlp.W[window.window_bits], N, mm, temp_ipi);
-
-            /* Cleanup window data */
-            cleanup_window(&window);
+            apply_window(&window);
         }
     }
 
@@ -2231,6 +2705,34 @@ static uint32_t do_sliding_window_exp(void)
 
 }
 
+/**
+ * Used to make left-to-right binary exponentiation, if exponent fits in one limb.
+ * Window table is not needed, A * R mod N (W[0]) is used as only multiplicand.
+ * Each call of function means one iteration
+ * @return CDN_EOK
+ */
+static uint32_t do_small_exp(void)
+{
+    Ipi_t* dest_ipi = expModHlp.ipiPtr;
+    const Ipi_t* N = expModHlp.N;
+    uint32_t ei;
+
+    expModHlp.e_small_bits--;
+    ei = safe_shift32r(expModHlp.e_small, expModHlp.e_small_bits) & LIMB_TO_BIT_ITERATOR_MASK;
+
+    ipi_montsqr(dest_ipi, N, expModHlp.mm, &expModHlp.T);
+
+    if (ei != 0U) {
+        ipi_montmul(dest_ipi, &expModHlp.W[0], N, expModHlp.mm, &expModHlp.T);
+    }
+
+    if (expModHlp.e_small_bits == 0U) {
+        lib_handler.expModCalcCb = &correct_exp_result;
+    }
+
+    return CDN_EOK;
+}
+
 /**
  * Helper sanity function to check modulus N
  * @param[in] N, pointer to modulus N Ipi
@@ -2289,22 +2791,52 @@ static uint32_t init_exp_mod_helper(Ipi_t* ipiPtr, const Ipi_t* A, const Ipi_t*
     uint32_t i;
     uint32_t retVal;
     uint16_t size = N->num_limbs + 1U;
+    uint16_t aSize = get_num_of_used_limbs(A);
+
+    /* Initialize destination ipi. It is grown before arena is opened,
+     * because result has to stay valid when arena is closed. */
+    expModHlp.ipiPtr = ipiPtr;
+    retVal = ipi_grow(expModHlp.ipiPtr, size);
+
+    /* Get window size */
+    expModHlp.window_size = get_window_size(E);
+
+    /* Window is not used for small exponents */
+    expModHlp.e_small_bits = 0U;
+    if (ipi_msb_bitsnum(E) <= SMALL_EXP_MAX_BITS) {
+        expModHlp.e_small = E->ptr[0];
+        expModHlp.e_small_bits = (uint8_t)ipi_msb_bitsnum(E);
+        expModHlp.window_size = 1U;
+    }
+
+    /* Temporaries are released all at once, when operation is finished */
+    if (aSize < size) {
+        aSize = size;
+    }
+    ipi_arena_open(((uint32_t)size * (EXP_MOD_ARENA_SLOTS + (uint32_t)get_table_size())) + aSize);
 
     /* Initialize temporary ipi */
     ipi_init(&expModHlp.T);
-    retVal = ipi_grow(&expModHlp.T, (size * 2U));
+    retVal |= ipi_grow_scoped(&expModHlp.T, (size * 2U));
 
-    /* Initialize mm */
-    ipi_montg_init(&expModHlp.mm, N);
+    /* Initialize mm, if not taken from context */
+    if (expModHlp.ctx != NULL) {
+        expModHlp.mm = expModHlp.ctx->mm;
+    } else {
+        ipi_montg_init(&expModHlp.mm, N);
+    }
 
-    /* Initialize W */
-    for (i = 0; i < 64U; i++) {
+    /* Initialize W, only entries used by selected window */
+    for (i = 0U; i < EXP_MOD_TABLE_SIZE; i++) {
         ipi_init(&expModHlp.W[i]);
     }
-    retVal |= ipi_grow(&expModHlp.W[1],  size);
+    for (i = 0U; i < get_table_size(); i++) {
+        retVal |= ipi_grow_scoped(&expModHlp.W[i], size);
+    }
 
     /* Initialize A */
     ipi_init(&expModHlp.A);
+    retVal |= ipi_grow_scoped(&expModHlp.A, aSize);
     retVal |= ipi_copy(&expModHlp.A, A);
 
     expModHlp.isNeg = (A->sign == IPI_NEGATIVE_VAL );
@@ -2312,22 +2844,22 @@ static uint32_t init_exp_mod_helper(Ipi_t* ipiPtr, const Ipi_t* A, const Ipi_t*
         expModHlp.A.sign = IPI_POSITIVE_VAL;
     }
 
-    /* Get window size */
-    expModHlp.window_size = get_window_size(E);
-
-    /* Initialize destination ipi */
-    expModHlp.ipiPtr = ipiPtr;
-    retVal |= ipi_grow(expModHlp.ipiPtr, size);
-
     /* Initialize temporary buffer Z */
     ipi_init(&expModHlp.Z);
+    retVal |= ipi_grow_scoped(&expModHlp.Z, size);
 
     /* Initialize iterator of E */
     init_bit_iterator(&expModHlp.e_iterator, E);
 
     expModHlp.N = N;
 
-    lib_handler.expModCalcCb = &exp_prereq_calc_r2_handler;
+    if ((expModHlp.ctx != NULL) && expModHlp.ctx->isReady) {
+        /* R^2 mod N is taken from context */
+        retVal |= ipi_copy(&expModHlp.Z, &expModHlp.ctx->RR);
+        lib_handler.expModCalcCb = &exp_prereq_calc_x_dash_handler;
+    } else {
+        lib_handler.expModCalcCb = &exp_prereq_calc_r2_handler;
+    }
 
 
     return retVal;
@@ -2357,19 +2889,33 @@ static uint32_t correct_exp_result(void)
 static void cleanup_exp_mod_helper(void)
 {
     uint32_t i;
-    for (i = 0U; i < safe_shift32l(1U, expModHlp.window_size); i++) {
+    for (i = 0U; i < EXP_MOD_TABLE_SIZE; i++) {
         ipi_free(&expModHlp.W[i]);
     }
 
-    ipi_free(&expModHlp.W[1]);
     ipi_free(&expModHlp.T);
     ipi_free(&expModHlp.A);
+    ipi_free(&expModHlp.Z);
+
+    ipi_arena_close();
 
     lib_handler.expModCalcCb = NULL;
 
 }
 
-uint32_t ipi_exp_mod(Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, const Ipi_t *N)
+/**
+ * Sliding-window exponentiation, common for calls with and without Montgomery context
+ * @param[out] dest_ipi, pointer to destination IPI
+ * @param[in] A, pointer to left-hand IPI
+ * @param[in] E, pointer to exponent IPI
+ * @param[in] N, pointer to modular IPI
+ * @param[in, out] ctx, pointer to Montgomery context of N or NULL
+ * @return CDN_EOK if successful,
+ *         CDN_ENOMEM if memory allocation failed,
+ *         CDN_EINVAL if N is negative or even or if E is negative
+ *         CDN_EINPROGRESS if operation is not done yet
+ */
+static uint32_t exp_mod(Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, const Ipi_t *N, IpiMontCtx_t* ctx)
 {
     /* Logic of code ensure that will be initialized before first use.
      * Assignment only needed to avoid MISRA */
@@ -2384,6 +2930,7 @@ uint32_t ipi_exp_mod(Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, const Ipi_
         retVal = ipi_exp_mod_SF(dest_ipi, A, E, N);
 
         if (retVal == CDN_EOK) {
+            expModHlp.ctx = ctx;
             retVal = init_exp_mod_helper(dest_ipi, A, N, E);
         }
 
@@ -2408,5 +2955,47 @@ uint32_t ipi_exp_mod(Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, const Ipi_
 
     return retVal;
 }
+
+uint32_t ipi_exp_mod(Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, const Ipi_t *N)
+{
+    return exp_mod(dest_ipi, A, E, N, NULL);
+}
+
+uint32_t ipi_get_exp_mod_peak_mem(void)
+{
+    return expModPeakMem;
+}
+
+uint32_t ipi_mont_ctx_init(IpiMontCtx_t* ctx, uint32_t* nLimbs, uint32_t* rrLimbs, uint16_t limbsNum,
+                           const uint8_t* srcBuf, uint32_t bufLen)
+{
+    uint32_t retVal;
+
+    /* Context is unusable until modulus is verified */
+    ipi_init(&ctx->RR);
+    ctx->isReady = false;
+
+    retVal = ipi_rd_binary_static(&ctx->N, nLimbs, limbsNum, srcBuf, bufLen);
+
+    /* Montgomery multiplication needs odd modulus */
+    if ((retVal == CDN_EOK) && ((nLimbs[0] & 1U) == 0U)) {
+        ipi_init(&ctx->N);
+        retVal = CDN_EINVAL;
+    }
+
+    if (retVal == CDN_EOK) {
+        ctx->RR.num_limbs = ctx->N.num_limbs;
+        ctx->RR.ptr = rrLimbs;
+
+        ipi_montg_init(&ctx->mm, &ctx->N);
+    }
+
+    return retVal;
+}
+
+uint32_t ipi_exp_mod_ctx(Ipi_t *dest_ipi, const Ipi_t *A, const Ipi_t *E, IpiMontCtx_t* ctx)
+{
+    return exp_mod(dest_ipi, A, E, &ctx->N, ctx);
+}
 /* parasoft-end-suppress METRICS-36-3 */
 /* parasoft-end-suppress METRICS-41-3 */
@@ -107,7 +107,7 @@ uint8_t* MB_GetTxBuff(MB_TYPE type) {
 
 /** Check if Tx is ready */
 bool MB_IsTxReady(MB_TYPE type) {
-    return !mailBoxData[(uint8_t)type].portTxBusy;
+    return !mailBoxData[(uint8_t)type].portTxBusy && !mailBoxData[(uint8_t)type].txReserved;
 }
 
 /** Send message */
@@ -122,10 +122,48 @@ void MB_SendMsg(MB_TYPE type, uint32_t len, uint8_t opCode, MB_MODULE_ID moduleI
     mailBoxData[type].portTxBusy = true;
 }
 
+/** Reserve space for next message */
+uint8_t* MB_ReserveTxMsg(MB_TYPE type, uint32_t len) {
+    S_MAIL_BOX_DATA *mailBoxDataPtr = &mailBoxData[(uint8_t) type];
+    uint8_t* buff = NULL;
+
+    if (!mailBoxDataPtr->portTxBusy) {
+        // everything was sent, start from beginning of buffer
+        mailBoxDataPtr->txCur = 0U;
+        mailBoxDataPtr->txTotal = 0U;
+    }
+
+    // message is placed directly after messages being sent
+    if ((mailBoxDataPtr->txTotal + (uint32_t) MB_TXRXBUFF_DATA_IDX + len) <= (uint32_t) MAIL_BOX_MAX_TX_SIZE) {
+        mailBoxDataPtr->txReservedIdx = mailBoxDataPtr->txTotal;
+        mailBoxDataPtr->txReserved = true;
+        buff = &mailBoxDataPtr->txBuff[mailBoxDataPtr->txTotal + (uint32_t) MB_TXRXBUFF_DATA_IDX];
+    }
+
+    return buff;
+}
+
+/** Queue reserved message */
+void MB_QueueTxMsg(MB_TYPE type, uint32_t len, uint8_t opCode, MB_MODULE_ID moduleId) {
+    S_MAIL_BOX_DATA *mailBoxDataPtr = &mailBoxData[(uint8_t) type];
+    uint8_t* msg = &mailBoxDataPtr->txBuff[mailBoxDataPtr->txReservedIdx];
+
+    msg[MB_TXRXBUFF_OPCODE_IDX] = opCode;
+    msg[MB_TXRXBUFF_MODULE_ID_IDX] = (uint8_t) moduleId;
+    msg[MB_TXRXBUFF_SIZE_MSB_IDX] = GetByte1(len);
+    msg[MB_TXRXBUFF_SIZE_LSB_IDX] = GetByte0(len);
+
+    // if previous messages were sent in meantime, txCur already points to this message
+    mailBoxDataPtr->txTotal = mailBoxDataPtr->txReservedIdx + len + (uint32_t) MB_TXRXBUFF_DATA_IDX;
+    mailBoxDataPtr->txReserved = false;
+    mailBoxDataPtr->portTxBusy = true;
+}
+
 /** Initialize Regular mail box module */
 static void MB_Init_Regular(void) {
     mailBoxData[(uint8_t) MB_TYPE_REGULAR].rxState = MB_STATE_EMPTY;
     mailBoxData[(uint8_t) MB_TYPE_REGULAR].portTxBusy = false;
+    mailBoxData[(uint8_t) MB_TYPE_REGULAR].txReserved = false;
 
 }
 
@@ -133,6 +171,7 @@ static void MB_Init_Regular(void) {
 static void MB_Init_Secure(void) {
     mailBoxData[(uint8_t) MB_TYPE_SECURE].rxState = MB_STATE_EMPTY;
     mailBoxData[(uint8_t) MB_TYPE_SECURE].portTxBusy = false;
+    mailBoxData[(uint8_t) MB_TYPE_SECURE].txReserved = false;
 }
 
 /** Start to run mailbox thread */
@@ -77,13 +77,55 @@ static inline uint32_t convert_buffers_into_ipis(PublicKeyHlp_t* pubKeyHlp, Pkcs
     uint32_t retVal;
 
     /* Convert input buffer to ipi */
-    retVal  = ipi_rd_binary(&pubKeyHlp->buffer, pkcsHelper->input.ptr, pkcsHelper->input.size);
-    retVal |= ipi_rd_binary(&pubKeyHlp->exponent_e, pkcsHelper->exponent_e.ptr, pkcsHelper->exponent_e.size);
-    retVal |= ipi_rd_binary(&pubKeyHlp->modulus_n, pkcsHelper->modulus_n.ptr, pkcsHelper->modulus_n.size);
+    retVal = ipi_rd_binary(&pubKeyHlp->buffer, pkcsHelper->input.ptr, pkcsHelper->input.size);
+
+    /* Cached exponent is already converted */
+    if (pkcsHelper->exponent_ipi == NULL) {
+        retVal |= ipi_rd_binary(&pubKeyHlp->exponent_e, pkcsHelper->exponent_e.ptr, pkcsHelper->exponent_e.size);
+    }
+
+    /* Modulus from Montgomery context is already converted */
+    if (pkcsHelper->mont_ctx == NULL) {
+        retVal |= ipi_rd_binary(&pubKeyHlp->modulus_n, pkcsHelper->modulus_n.ptr, pkcsHelper->modulus_n.size);
+    }
 
     return retVal;
 }
 
+/**
+ * Returns modulus used in public key operation
+ * @param[in] pubKeyHlp, pointer to auxiliary public key structure
+ * @param[in] pkcsHelper, pointer to structure with pointers with data
+ * @return pointer to modulus Ipi
+ */
+static inline const Ipi_t* get_modulus(const PublicKeyHlp_t* pubKeyHlp, const PkcsParam_t* pkcsHelper)
+{
+    const Ipi_t* modulus = &pubKeyHlp->modulus_n;
+
+    if (pkcsHelper->mont_ctx != NULL) {
+        modulus = &pkcsHelper->mont_ctx->N;
+    }
+
+    return modulus;
+}
+
+/**
+ * Returns exponent used in public key operation
+ * @param[in] pubKeyHlp, pointer to auxiliary public key structure
+ * @param[in] pkcsHelper, pointer to structure with pointers with data
+ * @return pointer to exponent Ipi
+ */
+static inline const Ipi_t* get_exponent(const PublicKeyHlp_t* pubKeyHlp, const PkcsParam_t* pkcsHelper)
+{
+    const Ipi_t* exponent = &pubKeyHlp->exponent_e;
+
+    if (pkcsHelper->exponent_ipi != NULL) {
+        exponent = pkcsHelper->exponent_ipi;
+    }
+
+    return exponent;
+}
+
 /**
  * Public key generator
  * @param[in,out] pkcHelper, pointer to auxiliary structure
@@ -108,7 +150,7 @@ static uint32_t public_key_operation(PkcsParam_t* pkcsHelper)
 
             retVal = CDN_EINPROGRESS;
 
-            if (ipi_cmp(&pubKeyHelper.buffer, &pubKeyHelper.modulus_n) != COMPARISON_RESULT_LOWER) {
+            if (ipi_cmp(&pubKeyHelper.buffer, get_modulus(&pubKeyHelper, pkcsHelper)) != COMPARISON_RESULT_LOWER) {
                 retVal = CDN_EINVAL;
             }
         }
@@ -117,10 +159,17 @@ static uint32_t public_key_operation(PkcsParam_t* pkcsHelper)
 
     } else {
 
-        retVal = ipi_exp_mod(&pubKeyHelper.buffer,
-                             &pubKeyHelper.buffer,
-                             &pubKeyHelper.exponent_e,
-                             &pubKeyHelper.modulus_n);
+        if (pkcsHelper->mont_ctx != NULL) {
+            retVal = ipi_exp_mod_ctx(&pubKeyHelper.buffer,
+                                     &pubKeyHelper.buffer,
+                                     get_exponent(&pubKeyHelper, pkcsHelper),
+                                     pkcsHelper->mont_ctx);
+        } else {
+            retVal = ipi_exp_mod(&pubKeyHelper.buffer,
+                                 &pubKeyHelper.buffer,
+                                 get_exponent(&pubKeyHelper, pkcsHelper),
+                                 &pubKeyHelper.modulus_n);
+        }
 
         if (retVal == CDN_EOK) {
             /* Operation is finished without errors */
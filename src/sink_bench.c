@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * sink_bench.c
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_SINK_MODEL
+#include "sink_bench.h"
+#include "sink_model.h"
+#include "dp_tx.h"
+#include "timer.h"
+#include "utils.h"
+#include "cdn_log.h"
+
+#include <string.h>
+
+/* Number of hot-plug sequences in each scenario */
+#define SINK_BENCH_ITERATIONS 10U
+/* Size of buffer for read data (EDID base and extension block) */
+#define SINK_BENCH_BUFFER_SIZE 256U
+
+/**
+ * Single request of hot-plug sequence
+ */
+typedef struct {
+    /* Request command */
+    uint8_t command;
+    /* DPCD or I2C address */
+    uint32_t address;
+    /* Number of bytes to read/write */
+    uint32_t length;
+    /* Finish I2C transaction (MOT=0) after request */
+    bool endTransaction;
+    /* Byte written by write requests */
+    uint8_t data;
+} SinkBenchStep_t;
+
+typedef struct
+{
+    /* Current state */
+    StateCallback_t stateCb;
+    /* Index of current scenario */
+    uint8_t scenario;
+    /* Index of current step of sequence */
+    uint8_t step;
+    /* Number of completed sequences in current scenario */
+    uint32_t iteration;
+    /* Current request was finished by DP_TX */
+    bool stepDone;
+    /* Request given to DP_TX */
+    DpTxRequestData_t request;
+    /* Buffer for request data */
+    uint8_t buffer[SINK_BENCH_BUFFER_SIZE];
+    /* Results of scenarios */
+    SinkBenchResult_t results[SINK_BENCH_SCENARIOS];
+} SinkBenchData_t;
+
+static SinkBenchData_t sinkBenchData;
+
+/* Requests done by typical source after hot-plug */
+static const SinkBenchStep_t sequence[] = {
+    /* Receiver capabilities */
+    { (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, 0x00000U, 16U, false, 0U },
+    /* Sink count, IRQ vector and link status */
+    { (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, 0x00200U, 8U, false, 0U },
+    /* EDID offset */
+    { (uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)DP_REQUEST_WRITE, 0x50U, 1U, false, 0U },
+    /* EDID base and extension block */
+    { (uint8_t)DP_REQUEST_TYPE_I2C | (uint8_t)DP_REQUEST_READ, 0x50U, 256U, true, 0U },
+    /* SET_POWER to D0 */
+    { (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_WRITE, 0x00600U, 1U, false, 1U },
+    /* Lane status */
+    { (uint8_t)DP_REQUEST_TYPE_AUX | (uint8_t)DP_REQUEST_READ, 0x00202U, 6U, false, 0U },
+};
+
+#define SINK_BENCH_STEPS ((uint8_t)(sizeof(sequence) / sizeof(sequence[0])))
+
+/* Sink configurations used by scenarios */
+static const SinkModelConfig_t scenarios[SINK_BENCH_SCENARIOS] = {
+    /* Fast sink */
+    { .replyLatencyUs = 50U, .faultPatternLen = 0U },
+    /* Slow sink */
+    { .replyLatencyUs = 250U, .faultPatternLen = 0U },
+    /* Every 4th transaction deferred */
+    {
+        .replyLatencyUs = 50U,
+        .faultPattern = { SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_DEFER },
+        .faultPatternLen = 4U
+    },
+    /* Every 8th transaction without reply */
+    {
+        .replyLatencyUs = 50U,
+        .faultPattern = { SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE,
+                          SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_NONE, SINK_MODEL_FAULT_TIMEOUT },
+        .faultPatternLen = 8U
+    },
+};
+
+static void plugHandler(void);
+static void waitPlugHandler(void);
+static void stepHandler(void);
+static void waitStepHandler(void);
+static void unplugHandler(void);
+
+/**
+ * Callback of DP_TX request
+ * @param[in] reply, finished request
+ */
+static void requestCallback(const DpTxRequestData_t* reply)
+{
+    if (reply->bytes_reply < reply->length) {
+        sinkBenchData.results[sinkBenchData.scenario].failures++;
+    }
+
+    sinkBenchData.stepDone = true;
+}
+
+/**
+ * Save statistics of DP_TX module into result of current scenario
+ */
+static void saveScenarioResult(void)
+{
+    const DpTxStats_t* stats = DP_TX_getStats();
+    SinkBenchResult_t* result = &sinkBenchData.results[sinkBenchData.scenario];
+
+    result->auxTransactions = stats->aux.transactions;
+    result->i2cTransactions = stats->i2c.transactions;
+    result->retries = stats->aux.retryCount + stats->i2c.retryCount;
+    result->timeouts = stats->aux.timeoutCount + stats->i2c.timeoutCount;
+
+    cDbgMsg(DBG_GEN_MSG, DBG_CRIT, "sink_bench: scenario %d: %d sequences in %d us (max %d us), "
+            "%d AUX, %d I2C, %d retries, %d timeouts, %d failures\n",
+            sinkBenchData.scenario, result->iterations, result->totalUs, result->maxSequenceUs,
+            result->auxTransactions, result->i2cTransactions, result->retries, result->timeouts,
+            result->failures);
+}
+
+/**
+ * Start scenario: configure sink and clear statistics
+ */
+static void startScenarioHandler(void)
+{
+    SINK_MODEL_configure(&scenarios[sinkBenchData.scenario]);
+    DP_TX_resetStats();
+    sinkBenchData.iteration = 0U;
+    sinkBenchData.stateCb = &plugHandler;
+}
+
+/**
+ * Connect sink and start hot-plug sequence
+ */
+static void plugHandler(void)
+{
+    /* Wait until previous unplug is handled */
+    if (!DP_TX_isAvailable()) {
+        startTimer(SINK_BENCH_TIMER);
+        SINK_MODEL_plug();
+        sinkBenchData.step = 0U;
+        sinkBenchData.stateCb = &waitPlugHandler;
+    }
+}
+
+/**
+ * Wait until DP_TX handles plug event
+ */
+static void waitPlugHandler(void)
+{
+    if (DP_TX_isPlugged()) {
+        sinkBenchData.stateCb = &stepHandler;
+    }
+}
+
+/**
+ * Send next request of sequence
+ */
+static void stepHandler(void)
+{
+    const SinkBenchStep_t* step = &sequence[sinkBenchData.step];
+
+    sinkBenchData.request.command = step->command;
+    sinkBenchData.request.address = step->address;
+    sinkBenchData.request.length = step->length;
+    sinkBenchData.request.endTransaction = step->endTransaction;
+    sinkBenchData.request.buffer = sinkBenchData.buffer;
+    sinkBenchData.buffer[0] = step->data;
+    sinkBenchData.stepDone = false;
+
+    switch (DP_TX_submitWhenFree(&sinkBenchData.request, &requestCallback, 0U, DP_TX_SUBMIT_NO_TIMEOUT)) {
+    case DP_TX_SUBMIT_STATUS_SUBMITTED:
+        sinkBenchData.stateCb = &waitStepHandler;
+        break;
+    case DP_TX_SUBMIT_STATUS_NO_SINK:
+        /* Sink was unplugged, sequence is not counted */
+        sinkBenchData.results[sinkBenchData.scenario].failures++;
+        sinkBenchData.stateCb = &unplugHandler;
+        break;
+    default:
+        /* Wait for DP_TX module */
+        break;
+    }
+}
+
+/**
+ * Wait for end of request, finish sequence after last request
+ */
+static void waitStepHandler(void)
+{
+    SinkBenchResult_t* result = &sinkBenchData.results[sinkBenchData.scenario];
+    uint32_t sequenceUs;
+
+    if (sinkBenchData.stepDone) {
+        sinkBenchData.step++;
+
+        if (sinkBenchData.step < SINK_BENCH_STEPS) {
+            sinkBenchData.stateCb = &stepHandler;
+        } else {
+            sequenceUs = getTimerUsWithoutUpdate(SINK_BENCH_TIMER);
+            result->iterations++;
+            result->totalUs += sequenceUs;
+            if (sequenceUs > result->maxSequenceUs) {
+                result->maxSequenceUs = sequenceUs;
+            }
+
+            sinkBenchData.stateCb = &unplugHandler;
+        }
+    }
+}
+
+/**
+ * Disconnect sink, start next sequence or scenario
+ */
+static void unplugHandler(void)
+{
+    /* Wait until DP_TX is idle after last request (or sink is already gone) */
+    if ((!DP_TX_isPlugged()) || DP_TX_isAvailable()) {
+        SINK_MODEL_unplug();
+        sinkBenchData.iteration++;
+
+        if (sinkBenchData.iteration < SINK_BENCH_ITERATIONS) {
+            sinkBenchData.stateCb = &plugHandler;
+        } else {
+            saveScenarioResult();
+            sinkBenchData.scenario++;
+
+            if (sinkBenchData.scenario < SINK_BENCH_SCENARIOS) {
+                sinkBenchData.stateCb = &startScenarioHandler;
+            } else {
+                /* Benchmark finished */
+                sinkBenchData.stateCb = NULL;
+            }
+        }
+    }
+}
+
+/**
+ * Main thread of benchmark driver
+ */
+static void SINK_BENCH_thread(void)
+{
+    if (sinkBenchData.stateCb != NULL) {
+        (*sinkBenchData.stateCb)();
+    } else {
+        modRunnerSuspendMe();
+    }
+}
+
+/**
+ * Function used to start benchmark driver
+ */
+static void SINK_BENCH_start(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize benchmark driver
+ */
+static void SINK_BENCH_init(void)
+{
+    (void)memset(sinkBenchData.results, 0, sizeof(sinkBenchData.results));
+    sinkBenchData.scenario = 0U;
+    sinkBenchData.stateCb = &startScenarioHandler;
+}
+
+const SinkBenchResult_t* SINK_BENCH_getResults(void)
+{
+    return sinkBenchData.results;
+}
+
+bool SINK_BENCH_isFinished(void)
+{
+    return sinkBenchData.scenario >= SINK_BENCH_SCENARIOS;
+}
+
+void SINK_BENCH_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t sinkBenchModule;
+
+    sinkBenchModule.initTask = &SINK_BENCH_init;
+    sinkBenchModule.startTask = &SINK_BENCH_start;
+    sinkBenchModule.thread = &SINK_BENCH_thread;
+    sinkBenchModule.moduleId = MODRUNNER_MODULE_SINK_BENCH;
+    sinkBenchModule.pPriority = 0U;
+
+    modRunnerInsertModule(&sinkBenchModule);
+}
+
+#endif // USE_SINK_MODEL
@@ -0,0 +1,666 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/**
+ * Cadence Display Port Xtensa Firmware
+ *
+ * Copyright (C) 2019 Cadence Design Systems
+ *
+ * http://www.cadence.com
+ *
+ ******************************************************************************
+ *
+ * sink_model.c
+ *
+ ******************************************************************************
+ */
+
+#ifdef USE_SINK_MODEL
+#include "sink_model.h"
+#include "dp_tx.h"
+#include "interrupt.h"
+#include "timer.h"
+#include "utils.h"
+#include "reg.h"
+
+#include <string.h>
+
+/* Size of modelled DPCD memory map (receiver capability, link configuration and status fields) */
+#define SINK_MODEL_DPCD_SIZE 0x300U
+/* DPCD addresses used by model */
+#define SINK_MODEL_DPCD_REV                        0x000U
+#define SINK_MODEL_DPCD_MAX_LINK_RATE              0x001U
+#define SINK_MODEL_DPCD_MAX_LANE_COUNT             0x002U
+#define SINK_MODEL_DPCD_MAX_DOWNSPREAD             0x003U
+#define SINK_MODEL_DPCD_SINK_COUNT                 0x200U
+#define SINK_MODEL_DPCD_DEVICE_SERVICE_IRQ_VECTOR  0x201U
+#define SINK_MODEL_DPCD_LANE0_1_STATUS             0x202U
+#define SINK_MODEL_DPCD_LANE2_3_STATUS             0x203U
+#define SINK_MODEL_DPCD_LANE_ALIGN_STATUS_UPDATED  0x204U
+#define SINK_MODEL_DPCD_SET_POWER                  0x600U
+/* Size of EDID (base block and one extension block) */
+#define SINK_MODEL_EDID_SIZE 256U
+/* Size of single EDID block */
+#define SINK_MODEL_EDID_BLOCK_SIZE 128U
+/* I2C address of EDID */
+#define SINK_MODEL_EDID_I2C_ADDR 0x50U
+/* I2C address of E-DDC segment pointer */
+#define SINK_MODEL_SEGMENT_I2C_ADDR 0x30U
+/* Maximum number of words in request (header, length and data) */
+#define SINK_MODEL_REQUEST_MAX_WORDS (4U + DP_MAX_DATA_LEN)
+/* Maximum number of words in reply (command and data) */
+#define SINK_MODEL_REPLY_MAX_WORDS (1U + DP_MAX_DATA_LEN)
+/* Time of AUX frame without data in microseconds (1 Mbps Manchester-II:
+   16 zeros of preamble, SYNC-END and STOP) */
+#define SINK_MODEL_FRAME_OVERHEAD_US 24U
+/* Time of single AUX byte in microseconds */
+#define SINK_MODEL_BYTE_TIME_US 8U
+/* Default time between end of request and start of reply in microseconds */
+#define SINK_MODEL_DEFAULT_REPLY_LATENCY_US 50U
+/* Frequency of AUX controller timer in MHz (2 MHz clock set by DP_AUX_DIVIDE_2M) */
+#define SINK_MODEL_AUX_TIMER_CLOCK_MHZ 2U
+/* Masks of AUX frame start and end bits */
+#define SINK_MODEL_FRAME_START 0x100U
+#define SINK_MODEL_FRAME_END 0x200U
+/* Offset of command in first word of request and reply */
+#define SINK_MODEL_COMMAND_OFFSET 4U
+/* Mask of data in transaction word */
+#define SINK_MODEL_DATA_MASK 0xFFU
+
+/* Address of register owned by model */
+#define SINK_MODEL_REG(reg) (&mhdpRegBase->mhdp_apb_regs.reg##_p)
+
+typedef struct
+{
+    /* Pending event, NULL if model is idle */
+    StateCallback_t stateCb;
+    /* Time after which pending event is performed, counted from SINK_MODEL_TIMER start */
+    uint32_t eventDelayUs;
+    /* Configuration given by SINK_MODEL_configure */
+    SinkModelConfig_t config;
+    /* Index of fault pattern entry used by next transaction */
+    uint8_t faultIdx;
+    /* Fault injected into current transaction */
+    SinkModelFault_t fault;
+    /* Words of request written into DP_AUX_TX_DATA */
+    uint32_t request[SINK_MODEL_REQUEST_MAX_WORDS];
+    /* Number of words in request */
+    uint8_t requestLen;
+    /* Words of reply read from DP_AUX_RX_DATA */
+    uint32_t reply[SINK_MODEL_REPLY_MAX_WORDS];
+    /* Number of words in reply */
+    uint8_t replyLen;
+    /* Index of next reply word to read */
+    uint8_t replyIdx;
+    /* Pending bits of DP_AUX_INTERRUPT_SOURCE */
+    uint32_t auxIrqSource;
+    /* Pending bits of HPD_EVENT_DET */
+    uint32_t hpdEvent;
+    /* Sink is connected */
+    bool plugged;
+    /* Reply timeout of AUX controller in microseconds */
+    uint32_t replyTimeoutUs;
+    /* E-DDC segment pointer */
+    uint8_t edidSegment;
+    /* EDID offset, incremented by reads */
+    uint8_t edidOffset;
+    /* DPCD memory map */
+    uint8_t dpcd[SINK_MODEL_DPCD_SIZE];
+    /* SET_POWER DPCD register */
+    uint8_t setPower;
+    /* EDID memory */
+    uint8_t edid[SINK_MODEL_EDID_SIZE];
+} SinkModelData_t;
+
+static SinkModelData_t sinkModelData;
+
+/**
+ * Calculate time of AUX frame on the wire
+ * @param[in] words, number of bytes in frame
+ * @return time in microseconds
+ */
+static inline uint32_t getFrameTimeUs(uint8_t words)
+{
+    return SINK_MODEL_FRAME_OVERHEAD_US + ((uint32_t)words * SINK_MODEL_BYTE_TIME_US);
+}
+
+/**
+ * Schedule event of model
+ * @param[in] cb, event handler
+ * @param[in] delayUs, time after which event is performed
+ */
+static void scheduleEvent(StateCallback_t cb, uint32_t delayUs)
+{
+    startTimer(SINK_MODEL_TIMER);
+    sinkModelData.eventDelayUs = delayUs;
+    sinkModelData.stateCb = cb;
+}
+
+/**
+ * Set AUX interrupt source bit and call interrupt handler
+ * @param[in] mask, mask of DP_AUX_INTERRUPT_SOURCE bit
+ */
+static void raiseAuxInterrupt(uint32_t mask)
+{
+    sinkModelData.auxIrqSource |= mask;
+    interruptRaise();
+}
+
+/**
+ * Set HPD event bit and call interrupt handler
+ * @param[in] mask, mask of HPD_EVENT_DET bit
+ */
+static void raiseHpdInterrupt(uint32_t mask)
+{
+    sinkModelData.hpdEvent |= mask;
+    interruptRaise();
+}
+
+/**
+ * Handler of reply, called when reply was received by controller
+ */
+static void rxDoneHandler(void)
+{
+    sinkModelData.stateCb = NULL;
+    raiseAuxInterrupt(RegFieldSet(DP_AUX_INTERRUPT_SOURCE, AUX_MAIN_RX_STATUS_DONE, 0U));
+}
+
+/**
+ * Handler of reply timeout, called when controller reply timer expires
+ */
+static void expireHandler(void)
+{
+    sinkModelData.stateCb = NULL;
+    raiseAuxInterrupt(RegFieldSet(DP_AUX_INTERRUPT_SOURCE, AUX_MAIN_EXPIRE_TX, 0U));
+}
+
+/**
+ * Handler of end of request, called when request was sent by controller
+ */
+static void txDoneHandler(void)
+{
+    if (sinkModelData.fault == SINK_MODEL_FAULT_TIMEOUT) {
+        scheduleEvent(&expireHandler, sinkModelData.replyTimeoutUs);
+    } else {
+        scheduleEvent(&rxDoneHandler, sinkModelData.config.replyLatencyUs + getFrameTimeUs(sinkModelData.replyLen));
+    }
+
+    raiseAuxInterrupt(RegFieldSet(DP_AUX_INTERRUPT_SOURCE, AUX_TX_DONE, 0U));
+}
+
+/**
+ * Get fault for next transaction from pattern
+ * @return fault to inject
+ */
+static SinkModelFault_t getNextFault(void)
+{
+    SinkModelFault_t fault = SINK_MODEL_FAULT_NONE;
+
+    if (sinkModelData.config.faultPatternLen > 0U) {
+        fault = sinkModelData.config.faultPattern[sinkModelData.faultIdx];
+        sinkModelData.faultIdx++;
+
+        if (sinkModelData.faultIdx >= sinkModelData.config.faultPatternLen) {
+            sinkModelData.faultIdx = 0U;
+        }
+    }
+
+    return fault;
+}
+
+/**
+ * Start reply with given reply command
+ * @param[in] replyCode, reply command (AUX and I2C part)
+ */
+static inline void startReply(uint8_t replyCode)
+{
+    sinkModelData.reply[0] = (uint32_t)replyCode << SINK_MODEL_COMMAND_OFFSET;
+    sinkModelData.replyLen = 1U;
+    sinkModelData.replyIdx = 0U;
+}
+
+/**
+ * Append data byte to reply
+ * @param[in] data, byte to append
+ */
+static inline void appendReply(uint8_t data)
+{
+    if (sinkModelData.replyLen < SINK_MODEL_REPLY_MAX_WORDS) {
+        sinkModelData.reply[sinkModelData.replyLen] = data;
+        sinkModelData.replyLen++;
+    }
+}
+
+/**
+ * Read DPCD register
+ * @param[in] address, DPCD address
+ * @return value of register, 0 for not modelled registers
+ */
+static uint8_t readDpcd(uint32_t address)
+{
+    uint8_t value = 0U;
+
+    if (address < SINK_MODEL_DPCD_SIZE) {
+        value = sinkModelData.dpcd[address];
+    } else if (address == SINK_MODEL_DPCD_SET_POWER) {
+        value = sinkModelData.setPower;
+    } else {
+        /* Not modelled register, read as 0 */
+    }
+
+    return value;
+}
+
+/**
+ * Write DPCD register
+ * @param[in] address, DPCD address
+ * @param[in] value, written value
+ */
+static void writeDpcd(uint32_t address, uint8_t value)
+{
+    if (address == SINK_MODEL_DPCD_DEVICE_SERVICE_IRQ_VECTOR) {
+        /* Write 1 to clear */
+        sinkModelData.dpcd[address] &= (uint8_t)~value;
+    } else if (address < SINK_MODEL_DPCD_SIZE) {
+        sinkModelData.dpcd[address] = value;
+    } else if (address == SINK_MODEL_DPCD_SET_POWER) {
+        sinkModelData.setPower = value;
+    } else {
+        /* Not modelled register, write is ignored */
+    }
+}
+
+/**
+ * Serve native AUX request
+ * @param[in] requestCode, DP_REQUEST_READ or DP_REQUEST_WRITE
+ * @param[in] address, DPCD address
+ * @param[in] length, number of bytes to read (0 for address-only transaction)
+ */
+static void serveAux(uint8_t requestCode, uint32_t address, uint8_t length)
+{
+    uint8_t i;
+
+    startReply((uint8_t)DP_REPLY_ACK);
+
+    if (requestCode == (uint8_t)DP_REQUEST_READ) {
+        for (i = 0U; i < length; i++) {
+            appendReply(readDpcd(address + i));
+        }
+    } else if (requestCode == (uint8_t)DP_REQUEST_WRITE) {
+        /* Data starts after header and length words */
+        for (i = 4U; i < sinkModelData.requestLen; i++) {
+            writeDpcd(address + i - 4U, (uint8_t)(sinkModelData.request[i] & SINK_MODEL_DATA_MASK));
+        }
+    } else {
+        startReply((uint8_t)DP_REPLY_NACK);
+    }
+}
+
+/**
+ * Serve request to EDID I2C slave
+ * @param[in] requestCode, DP_REQUEST_READ, DP_REQUEST_WRITE or DP_REQUEST_WRITE_UPDATE
+ * @param[in] length, number of bytes to read
+ */
+static void serveEdid(uint8_t requestCode, uint8_t length)
+{
+    uint8_t i;
+
+    startReply((uint8_t)DP_REPLY_ACK);
+
+    if (requestCode == (uint8_t)DP_REQUEST_READ) {
+        if (sinkModelData.edidSegment != 0U) {
+            /* Only segment 0 is present */
+            startReply((uint8_t)DP_REPLY_NACK << DP_REPLY_I2C_OFFSET);
+        } else {
+            for (i = 0U; i < length; i++) {
+                appendReply(sinkModelData.edid[sinkModelData.edidOffset]);
+                sinkModelData.edidOffset++;
+            }
+        }
+    } else if ((requestCode == (uint8_t)DP_REQUEST_WRITE) && (sinkModelData.requestLen > 4U)) {
+        /* First written byte is offset, rest is ignored (EDID is read-only) */
+        sinkModelData.edidOffset = (uint8_t)(sinkModelData.request[4] & SINK_MODEL_DATA_MASK);
+    } else {
+        /* Address-only and write-status-update transactions are acknowledged */
+    }
+}
+
+/**
+ * Serve I2C-over-AUX request
+ * @param[in] command, request command
+ * @param[in] address, I2C address
+ * @param[in] length, number of bytes to read
+ */
+static void serveI2c(uint8_t command, uint32_t address, uint8_t length)
+{
+    uint8_t requestCode = command & (uint8_t)DP_REQUEST_MASK;
+
+    if (address == SINK_MODEL_EDID_I2C_ADDR) {
+        serveEdid(requestCode, length);
+    } else if (address == SINK_MODEL_SEGMENT_I2C_ADDR) {
+        startReply((uint8_t)DP_REPLY_ACK);
+        if ((requestCode == (uint8_t)DP_REQUEST_WRITE) && (sinkModelData.requestLen > 4U)) {
+            sinkModelData.edidSegment = (uint8_t)(sinkModelData.request[4] & SINK_MODEL_DATA_MASK);
+        }
+    } else {
+        /* No device on given address */
+        startReply((uint8_t)DP_REPLY_NACK << DP_REPLY_I2C_OFFSET);
+    }
+
+    /* Segment pointer is reset by STOP condition (E-DDC) */
+    if ((command & (uint8_t)DP_REQUEST_I2C_MOT_MASK) == 0U) {
+        sinkModelData.edidSegment = 0U;
+    }
+}
+
+/**
+ * Prepare reply with injected fault
+ * @param[in] command, request command
+ */
+static void serveFault(uint8_t command)
+{
+    bool isAux = (command & (uint8_t)DP_REQUEST_TYPE_MASK) == (uint8_t)DP_REQUEST_TYPE_AUX;
+    bool isWrite = (command & (uint8_t)DP_REQUEST_MASK) == (uint8_t)DP_REQUEST_WRITE;
+
+    if (sinkModelData.fault == SINK_MODEL_FAULT_DEFER) {
+        startReply((uint8_t)DP_REPLY_DEFER);
+    } else if (isAux) {
+        startReply((uint8_t)DP_REPLY_NACK);
+    } else {
+        startReply((uint8_t)DP_REPLY_NACK << DP_REPLY_I2C_OFFSET);
+    }
+
+    /* NACK reply to write request carries number of written bytes */
+    if ((sinkModelData.fault == SINK_MODEL_FAULT_NACK) && isWrite && (sinkModelData.requestLen > 4U)) {
+        appendReply(0U);
+    }
+}
+
+/**
+ * Decode request written by DP_TX module and prepare reply
+ *
+ *  Request words: 0: | START | command | address[19:16] |
+ *                 1: | address[15:8] |
+ *                 2: | address[7:0]  | (END for address-only transaction)
+ *                 3: | length - 1    | (END for read transaction)
+ *                 4..: | data        | (END on last byte)
+ */
+static void processRequest(void)
+{
+    const uint32_t* request = sinkModelData.request;
+    uint8_t command = (uint8_t)((request[0] >> SINK_MODEL_COMMAND_OFFSET) & 0x0FU);
+    uint32_t address;
+    uint8_t length = 0U;
+
+    sinkModelData.fault = getNextFault();
+
+    if (sinkModelData.requestLen < 3U) {
+        /* Malformed request, sink does not reply */
+        sinkModelData.fault = SINK_MODEL_FAULT_TIMEOUT;
+        sinkModelData.replyLen = 0U;
+    } else {
+        address = ((request[0] & 0x0FU) << 16)
+                | ((request[1] & SINK_MODEL_DATA_MASK) << 8)
+                | (request[2] & SINK_MODEL_DATA_MASK);
+
+        if (sinkModelData.requestLen > 3U) {
+            length = (uint8_t)(request[3] & SINK_MODEL_DATA_MASK) + 1U;
+        }
+
+        if (sinkModelData.fault != SINK_MODEL_FAULT_NONE) {
+            serveFault(command);
+        } else if ((command & (uint8_t)DP_REQUEST_TYPE_MASK) == (uint8_t)DP_REQUEST_TYPE_AUX) {
+            serveAux(command & (uint8_t)DP_REQUEST_MASK, address, length);
+        } else {
+            serveI2c(command, address, length);
+        }
+
+        sinkModelData.reply[sinkModelData.replyLen - 1U] |= SINK_MODEL_FRAME_END;
+    }
+
+    scheduleEvent(&txDoneHandler, getFrameTimeUs(sinkModelData.requestLen));
+    modRunnerWake(MODRUNNER_MODULE_SINK_MODEL);
+}
+
+/**
+ * Collect word written into DP_AUX_TX_DATA
+ * @param[in] value, written word
+ */
+static void collectRequest(uint32_t value)
+{
+    if ((value & SINK_MODEL_FRAME_START) != 0U) {
+        sinkModelData.requestLen = 0U;
+    }
+
+    if (sinkModelData.requestLen < SINK_MODEL_REQUEST_MAX_WORDS) {
+        sinkModelData.request[sinkModelData.requestLen] = value;
+        sinkModelData.requestLen++;
+    }
+
+    if ((value & SINK_MODEL_FRAME_END) != 0U) {
+        processRequest();
+    }
+}
+
+/**
+ * Read next word of reply
+ * @return reply word, END sync if whole reply was read
+ */
+static uint32_t readReply(void)
+{
+    uint32_t value = SINK_MODEL_FRAME_END;
+
+    if (sinkModelData.replyIdx < sinkModelData.replyLen) {
+        value = sinkModelData.reply[sinkModelData.replyIdx];
+        sinkModelData.replyIdx++;
+    }
+
+    return value;
+}
+
+/**
+ * Fill EDID block checksum
+ * @param[in] block, pointer to EDID block
+ */
+static void setEdidChecksum(uint8_t* block)
+{
+    uint8_t sum = 0U;
+    uint8_t i;
+
+    for (i = 0U; i < (SINK_MODEL_EDID_BLOCK_SIZE - 1U); i++) {
+        sum += block[i];
+    }
+
+    block[SINK_MODEL_EDID_BLOCK_SIZE - 1U] = (uint8_t)(0x100U - (uint32_t)sum);
+}
+
+/**
+ * Fill EDID with EDID 1.4 base block and empty CTA-861 extension
+ */
+static void initEdid(void)
+{
+    static const uint8_t header[8] = { 0x00U, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x00U };
+    uint8_t* edid = sinkModelData.edid;
+
+    (void)memset(edid, 0, SINK_MODEL_EDID_SIZE);
+    (void)memcpy(edid, header, sizeof(header));
+
+    /* Manufacturer ID "CDN" */
+    edid[8] = 0x0CU;
+    edid[9] = 0x8EU;
+    /* EDID version 1.4 */
+    edid[18] = 0x01U;
+    edid[19] = 0x04U;
+    /* Digital input, 8 bits per color, DisplayPort */
+    edid[20] = 0xA5U;
+    /* Number of extensions */
+    edid[126] = 0x01U;
+
+    /* CTA-861 extension, revision 3, no data blocks */
+    edid[SINK_MODEL_EDID_BLOCK_SIZE] = 0x02U;
+    edid[SINK_MODEL_EDID_BLOCK_SIZE + 1U] = 0x03U;
+    edid[SINK_MODEL_EDID_BLOCK_SIZE + 2U] = 0x04U;
+
+    setEdidChecksum(&edid[0]);
+    setEdidChecksum(&edid[SINK_MODEL_EDID_BLOCK_SIZE]);
+}
+
+/**
+ * Fill DPCD with capabilities of DP 1.2 sink, 4 lanes HBR2, trained link
+ */
+static void initDpcd(void)
+{
+    uint8_t* dpcd = sinkModelData.dpcd;
+
+    (void)memset(dpcd, 0, SINK_MODEL_DPCD_SIZE);
+
+    dpcd[SINK_MODEL_DPCD_REV] = 0x12U;
+    dpcd[SINK_MODEL_DPCD_MAX_LINK_RATE] = 0x14U;
+    /* 4 lanes, enhanced frame capable */
+    dpcd[SINK_MODEL_DPCD_MAX_LANE_COUNT] = 0x84U;
+    dpcd[SINK_MODEL_DPCD_MAX_DOWNSPREAD] = 0x01U;
+    dpcd[SINK_MODEL_DPCD_SINK_COUNT] = 0x01U;
+    /* CR, EQ and symbol lock done on all lanes, lanes aligned */
+    dpcd[SINK_MODEL_DPCD_LANE0_1_STATUS] = 0x77U;
+    dpcd[SINK_MODEL_DPCD_LANE2_3_STATUS] = 0x77U;
+    dpcd[SINK_MODEL_DPCD_LANE_ALIGN_STATUS_UPDATED] = 0x01U;
+
+    /* D3 power state */
+    sinkModelData.setPower = 0x02U;
+}
+
+/**
+ * Main thread of sink model, performs pending event when its time elapsed
+ */
+static void SINK_MODEL_thread(void)
+{
+    uint32_t elapsedUs = getTimerUsWithoutUpdate(SINK_MODEL_TIMER);
+
+    if (sinkModelData.stateCb == NULL) {
+        /* Woken up by next request */
+        modRunnerSuspendMe();
+    } else if (elapsedUs < sinkModelData.eventDelayUs) {
+        modRunnerSleep(sinkModelData.eventDelayUs - elapsedUs);
+    } else {
+        (*sinkModelData.stateCb)();
+    }
+}
+
+/**
+ * Function used to start sink model
+ */
+static void SINK_MODEL_start(void)
+{
+    modRunnerWakeMe();
+}
+
+/**
+ * Function used to initialize sink model
+ */
+static void SINK_MODEL_init(void)
+{
+    sinkModelData.stateCb = NULL;
+    sinkModelData.requestLen = 0U;
+    sinkModelData.replyLen = 0U;
+    sinkModelData.replyIdx = 0U;
+    sinkModelData.auxIrqSource = 0U;
+    sinkModelData.hpdEvent = 0U;
+    sinkModelData.plugged = false;
+    sinkModelData.edidSegment = 0U;
+    sinkModelData.edidOffset = 0U;
+    sinkModelData.faultIdx = 0U;
+    sinkModelData.config.replyLatencyUs = SINK_MODEL_DEFAULT_REPLY_LATENCY_US;
+    sinkModelData.config.faultPatternLen = 0U;
+
+    initDpcd();
+    initEdid();
+}
+
+void SINK_MODEL_configure(const SinkModelConfig_t* config)
+{
+    sinkModelData.config = *config;
+
+    if (sinkModelData.config.faultPatternLen > SINK_MODEL_FAULT_PATTERN_LEN) {
+        sinkModelData.config.faultPatternLen = SINK_MODEL_FAULT_PATTERN_LEN;
+    }
+
+    sinkModelData.faultIdx = 0U;
+}
+
+void SINK_MODEL_plug(void)
+{
+    sinkModelData.plugged = true;
+    raiseHpdInterrupt(RegFieldSet(HPD_EVENT_DET, HPD_RE_PLGED_DET_EVENT, 0U));
+}
+
+void SINK_MODEL_unplug(void)
+{
+    sinkModelData.plugged = false;
+    raiseHpdInterrupt(RegFieldSet(HPD_EVENT_DET, HPD_UNPLUGGED_DET_ACLK, 0U));
+}
+
+void SINK_MODEL_irqHpd(void)
+{
+    raiseHpdInterrupt(RegFieldSet(HPD_EVENT_DET, HPD_IRQ_DET_EVENT, 0U));
+}
+
+bool SINK_MODEL_regRead(const volatile uint32_t* address, uint32_t* value)
+{
+    bool served = true;
+
+    if (address == SINK_MODEL_REG(DP_AUX_RX_DATA)) {
+        *value = readReply();
+    } else if (address == SINK_MODEL_REG(DP_AUX_INTERRUPT_SOURCE)) {
+        /* Read to clear */
+        *value = sinkModelData.auxIrqSource;
+        sinkModelData.auxIrqSource = 0U;
+    } else if (address == SINK_MODEL_REG(HPD_EVENT_DET)) {
+        /* Read to clear, except of HPD level */
+        *value = sinkModelData.hpdEvent;
+        if (sinkModelData.plugged) {
+            *value |= RegFieldSet(HPD_EVENT_DET, HPD_IN_SYNC, 0U);
+        }
+        sinkModelData.hpdEvent = 0U;
+    } else if (address == SINK_MODEL_REG(DPTX_INT_STATUS)) {
+        *value = 0U;
+        if (sinkModelData.hpdEvent != 0U) {
+            *value = RegFieldWrite(DPTX_INT_STATUS, DPTX_SRC_INT, 0U, 1U);
+        }
+    } else {
+        served = false;
+    }
+
+    return served;
+}
+
+bool SINK_MODEL_regWrite(const volatile uint32_t* address, uint32_t value)
+{
+    bool served = false;
+
+    if (address == SINK_MODEL_REG(DP_AUX_TX_DATA)) {
+        collectRequest(value);
+        served = true;
+    } else if (address == SINK_MODEL_REG(DP_AUX_TIMER_PRESET)) {
+        /* Written also to hardware */
+        sinkModelData.replyTimeoutUs = RegFieldRead(DP_AUX_TIMER_PRESET, AUX_HOST_TIMER_PRESET, value)
+                                     / SINK_MODEL_AUX_TIMER_CLOCK_MHZ;
+    } else {
+        /* Register not owned by model */
+    }
+
+    return served;
+}
+
+void SINK_MODEL_InsertModule(void)
+{
+    /* Have to be static to allow access from modRunner module */
+    static Module_t sinkModelModule;
+
+    sinkModelModule.initTask = &SINK_MODEL_init;
+    sinkModelModule.startTask = &SINK_MODEL_start;
+    sinkModelModule.thread = &SINK_MODEL_thread;
+    sinkModelModule.moduleId = MODRUNNER_MODULE_SINK_MODEL;
+    sinkModelModule.pPriority = 0U;
+
+    modRunnerInsertModule(&sinkModelModule);
+}
+
+#endif // USE_SINK_MODEL
@@ -27,6 +27,8 @@
 static uint32_t strips = 0;
 // amount of bytes currently allocated (counted as strips*BLOCK_SIZE)
 static uint32_t mem_allocated = 0;
+// the largest amount of bytes allocated at once
+static uint32_t max_mem_allocated = 0;
 
 static uint32_t data_for_allocation[MAX_NUMBER_OF_BLOCKS][BLOCK_SIZE/4U] __attribute__ ((aligned (4)));
 
@@ -142,7 +144,6 @@ static uint16_t malloc_static(uint16_t size) {
  * Return pointer to allocated data block or NULL if cannot allocate.
  */
 uint32_t* malloc_static_ptr32(uint16_t size) {
-    static uint32_t max_mem_allocated = 0;
     uint32_t *allocated_block_address = NULL;
     check_init();
     // Try to allocate
@@ -221,4 +222,14 @@ void free_static_ptr32(const uint32_t *ptr) {
     }
 }
 
+/* Return the largest amount of bytes allocated at once */
+uint32_t get_max_mem_allocated_static(void) {
+    return max_mem_allocated;
+}
+
+/* Start new measurement of the largest amount of allocated bytes */
+void reset_max_mem_allocated_static(void) {
+    max_mem_allocated = mem_allocated;
+}
+
 // parasoft-end-suppress METRICS-36-3 "A function should not be called from more than 5 different functions" DRV-3823